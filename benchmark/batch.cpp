@@ -0,0 +1,48 @@
+#include "bench_util.hpp"
+
+#include <gal/pga.hpp>
+
+#include <cmath>
+#include <vector>
+
+// Compares transforming an array of points by a single motor using the scalar `compute` path (one call per point)
+// against `compute_batch`.
+
+using namespace gal;
+using namespace gal::pga;
+
+int main()
+{
+    constexpr size_t count       = 1 << 20;
+    constexpr size_t repetitions = 10;
+
+    std::vector<point<float>> points;
+    points.reserve(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t = static_cast<float>(i);
+        points.emplace_back(std::sin(t), std::cos(t), 0.001f * t);
+    }
+    std::vector<point<float>> out(count, point<float>{0, 0, 0});
+
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    double scalar = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = compute(sandwich, points[i], m);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::report("point % motor (compute)", count, scalar);
+
+    double batch = bench::measure(repetitions, [&] {
+        compute_batch(sandwich, count, out.data(), points.data(), m);
+        bench::do_not_optimize(out);
+    });
+    bench::report("point % motor (compute_batch)", count, batch);
+
+    std::printf("speedup: %.2fx\n", scalar / batch);
+    return 0;
+}
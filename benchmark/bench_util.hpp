@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Minimal timing harness shared by the GAL benchmarks. The benchmarks are intentionally self-contained (no external
+// benchmarking framework) so they can be built anywhere the library itself can.
+
+namespace bench
+{
+// Prevent the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(T const& value) noexcept
+{
+#if defined(__clang__) || defined(__GNUG__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static_cast<void>(value);
+#endif
+}
+
+// Returns the best observed wall time (in seconds) of a single invocation of f over the given number of repetitions.
+// Taking the minimum filters out scheduling noise which only ever adds time.
+template <typename F>
+[[nodiscard]] double measure(size_t repetitions, F&& f)
+{
+    double best = 1e300;
+    for (size_t i = 0; i != repetitions; ++i)
+    {
+        auto start   = std::chrono::steady_clock::now();
+        f();
+        auto end     = std::chrono::steady_clock::now();
+        double delta = std::chrono::duration<double>(end - start).count();
+        if (delta < best)
+        {
+            best = delta;
+        }
+    }
+    return best;
+}
+
+inline void report(char const* label, size_t items, double seconds)
+{
+    std::printf("%-40s %12.3f ms %14.2f M items/s\n", label, seconds * 1e3, static_cast<double>(items) / seconds * 1e-6);
+}
+} // namespace bench
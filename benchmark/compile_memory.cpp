@@ -0,0 +1,29 @@
+#include <gal/cga.hpp>
+
+// Nothing here runs. The translation unit reifies conformal expressions whose intermediate products are large (the
+// outer products of several points and their duals) and so measures the memory and time taken by the compiler's
+// constant evaluation. The peak resident set size of the compiler is reported when the target is built (see
+// CMakeLists.txt).
+
+using namespace gal;
+using namespace gal::cga;
+
+using real_t  = double;
+using point_t = point<real_t>;
+
+// The flat point, circle and sphere through two, three and four points
+constexpr auto flat_point
+    = evaluate<point_t, point_t>{}([](auto p, auto q) { return (p ^ q ^ n_i<real_t>) >> ips<real_t>; });
+constexpr auto circle
+    = evaluate<point_t, point_t, point_t>{}([](auto p, auto q, auto r) { return (p ^ q ^ r) >> ips<real_t>; });
+constexpr auto sphere = evaluate<point_t, point_t, point_t, point_t>{}(
+    [](auto p, auto q, auto r, auto s) { return (p ^ q ^ r ^ s) >> ips<real_t>; });
+
+// Reflection of a point in the line through two others
+constexpr auto reflection = evaluate<point_t, point_t, point_t>{}(
+    [](auto p, auto q, auto r) { return p % ((q ^ r ^ n_i<real_t>) >> ips<real_t>); });
+
+int main()
+{
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "bench_util.hpp"
+
+#include <gal/pga.hpp>
+
+#include <cmath>
+#include <vector>
+
+// Compares the default evaluation of a point/motor sandwich against the `fp::fma` policy. Throughput transforms an
+// array of independent points while latency feeds each result back in as the next input so that every sandwich waits
+// on the one before it. Without hardware FMA support (e.g. -mfma on x86) `std::fma` is emulated and this policy loses.
+
+using namespace gal;
+using namespace gal::pga;
+
+int main()
+{
+    constexpr size_t count       = 1 << 20;
+    constexpr size_t repetitions = 10;
+
+    std::vector<point<float>> points;
+    points.reserve(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t = static_cast<float>(i);
+        points.emplace_back(std::sin(t), std::cos(t), 0.001f * t);
+    }
+    std::vector<point<float>> out(count, point<float>{0, 0, 0});
+
+    // A pure rotation so the chained point stays bounded
+    motor<float> m{0.92388f, 0.f, 0.f, 0.f, 0.f, 0.38268f, 0.f, 0.f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    double throughput = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = compute(sandwich, points[i], m);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::report("throughput (default)", count, throughput);
+
+    double throughput_fma = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = compute<fp::fma>(sandwich, points[i], m);
+        }
+        bench::do_not_optimize(out);
+    });
+    bench::report("throughput (fp::fma)", count, throughput_fma);
+
+    double latency = bench::measure(repetitions, [&] {
+        point<float> p = points[0];
+        for (size_t i = 0; i != count; ++i)
+        {
+            p = compute(sandwich, p, m);
+        }
+        bench::do_not_optimize(p);
+    });
+    bench::report("latency (default)", count, latency);
+
+    double latency_fma = bench::measure(repetitions, [&] {
+        point<float> p = points[0];
+        for (size_t i = 0; i != count; ++i)
+        {
+            p = compute<fp::fma>(sandwich, p, m);
+        }
+        bench::do_not_optimize(p);
+    });
+    bench::report("latency (fp::fma)", count, latency_fma);
+
+    std::printf("throughput speedup: %.2fx\n", throughput / throughput_fma);
+    std::printf("latency speedup: %.2fx\n", latency / latency_fma);
+    return 0;
+}
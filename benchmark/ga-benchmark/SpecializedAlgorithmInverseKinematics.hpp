@@ -32,53 +32,48 @@ using point  = point<real_t>;
 using scalar = gal::scalar<cga_algebra, real_t>;
 using namespace gal;
 
-// Fourth order exp expansion
+// Closed-form exponential of a generator produced by an earlier kernel
 template <typename T>
-inline auto expp(const T& arg)
+inline auto expv(const T& arg)
 {
-    auto arg2 = compute([](auto arg) { return arg * arg; }, arg);
-    return compute(
-        [](auto arg, auto arg2) {
-            auto arg3 = arg * arg2;
-            auto arg4 = arg2 * arg2;
-            return frac<1> + arg + arg2 / frac<2> + arg3 / frac<6> + arg4 / frac<24>;
-        },
-        arg, arg2);
+    return compute([](auto arg) { return versor_exp(arg); }, arg);
 }
 
 template <typename Scalar>
 auto
 InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, const Scalar& ang4, const Scalar& ang5)
 {
-    real_t d1 = 200.0, d2 = 680.0, d3 = 150.0, d4 = 140.0, d5 = 114.2;
-    real_t l12 = 890.0, l23 = 880.0;
-
-    real_t J1_x = d1;
-    real_t J1_y = 0.0;
-    real_t J1_z = d2;
-    real_t J2_x = d1;
-    real_t J2_y = 0.0;
-    real_t J2_z = d2 + l12;
-    real_t J3_x = d1 + l23;
-    real_t J3_y = 0.0;
-    real_t J3_z = d2 + l12 + d3;
-    real_t Jg_x = d1 + l23 + d4 + d5;
-    real_t Jg_y = 0.0;
-    real_t Jg_z = d2 + l12 + d3;
-
-    point J1{J1_x, J1_y, J1_z};
-    point J2{J2_x, J2_y, J2_z};
-    point J3{J3_x, J3_y, J3_z};
-    point Jg{Jg_x, Jg_y, Jg_z};
-    point Pz{0, 0, 1};
+    // The robot geometry is fixed so joint positions are compile-time constants folded into the kernels. Lengths are
+    // in tenths of a millimeter where needed (d5 = 114.2).
+    constexpr int d1 = 200, d2 = 680, d3 = 150, d4 = 140;
+    constexpr int l12 = 890, l23 = 880;
+
+    constexpr int J1_x = d1;
+    constexpr int J1_y = 0;
+    constexpr int J1_z = d2;
+    constexpr int J2_x = d1;
+    constexpr int J2_y = 0;
+    constexpr int J2_z = d2 + l12;
+    constexpr int J3_x = d1 + l23;
+    constexpr int J3_y = 0;
+    constexpr int J3_z = d2 + l12 + d3;
+    constexpr int Jg_x = 10 * (d1 + l23 + d4) + 1142;
+    constexpr int Jg_y = 0;
+    constexpr int Jg_z = 10 * (d2 + l12 + d3);
+
+    constant<point, J1_x, J1_y, J1_z> J1;
+    constant<point, J2_x, J2_y, J2_z> J2;
+    constant<point, J3_x, J3_y, J3_z> J3;
+    rational_constant<point, 10, Jg_x, Jg_y, Jg_z> Jg;
+    constant<point, 0, 0, 1> Pz;
 
     auto Lz = compute(
         [](auto Pz, auto ang1) { return frac<1, 2> * ang1 * ((n_o<real_t> ^ Pz ^ n_i<real_t>) >> ips<real_t>); },
         Pz,
         scalar{ang1});
-    auto R1 = expp(Lz);
+    auto R1 = expv(Lz);
 
-    point P2_help{J1_x, J1_y + 1.0, J1_z};
+    constant<point, J1_x, J1_y + 1, J1_z> P2_help;
 
     auto L2 = compute(
         [](auto R1, auto J1, auto P2_help, auto ang2) {
@@ -89,9 +84,9 @@ InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, co
         J1,
         P2_help,
         scalar{ang2});
-    auto R2 = expp(L2);
+    auto R2 = expv(L2);
 
-    point P3_help{J2_x, J2_y + 1.0, J2_z};
+    constant<point, J2_x, J2_y + 1, J2_z> P3_help;
 
     auto R21 = compute([](auto R1, auto R2) { return R2 * R1; }, R1, R2);
 
@@ -106,7 +101,7 @@ InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, co
         P3_help,
         scalar{ang3});
 
-    auto R3 = expp(L3);
+    auto R3 = expv(L3);
 
     auto [J2_rot1, t2_help] = compute(
         [](auto R1, auto J2, auto J2_f) {
@@ -118,13 +113,13 @@ InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, co
         J2,
         J2_f);
 
-    auto T2 = expp(t2_help);
+    auto T2 = expv(t2_help);
 
-    auto [L4init, L4weight, R3T2R1] = compute(
+    // The line is normalized by its weight within the same kernel
+    auto [L4init, R3T2R1] = compute(
         [](auto J3, auto Jg, auto R3, auto T2, auto R1) {
-            auto L4init   = (J3 ^ Jg ^ n_i<real_t>) >> ips<real_t>;
-            auto L4weight = L4init >> ~L4init;
-            return std::make_tuple(L4init, L4weight, R3 * T2 * R1);
+            auto L4init = (J3 ^ Jg ^ n_i<real_t>) >> ips<real_t>;
+            return std::make_tuple(L4init * inv(sqrt(L4init >> ~L4init)), R3 * T2 * R1);
         },
         J3,
         Jg,
@@ -132,19 +127,13 @@ InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, co
         T2,
         R1);
 
-    auto norm = L4weight[0] < 0 ? -std::sqrt(-L4weight[0]) : std::sqrt(L4weight[0]);
-    for (auto& component : L4init)
-    {
-        component /= norm;
-    }
-
     auto L4 = compute([](auto L4init, auto R3T2R1, auto ang4) { return frac<1, 2> * ang4 * (L4init % R3T2R1); },
                       L4init,
                       R3T2R1,
                       scalar{ang4});
-    auto R4 = expp(L4);
+    auto R4 = expv(L4);
 
-    point Pg_help{J3_x, J3_y + 1.0, J3_z};
+    constant<point, J3_x, J3_y + 1, J3_z> Pg_help;
     auto [Lginit, R4R3T2R1] = compute(
         [](auto R4, auto R3T2R1, auto J3, auto Pg_help) {
             auto Lginit   = (J3 ^ Pg_help ^ n_i<real_t>) >> ips<real_t>;
@@ -161,7 +150,7 @@ InverseKinematics(const Scalar& ang1, const Scalar& ang2, const Scalar& ang3, co
                       R4R3T2R1,
                       scalar{ang5});
 
-    auto Rg = expp(Lg);
+    auto Rg = expv(Lg);
 
     auto Rfinal = compute([](auto Rg, auto R4R3T2R1) { return Rg * R4R3T2R1; }, Rg, R4R3T2R1);
 
@@ -0,0 +1,67 @@
+#include "bench_util.hpp"
+
+#include <gal/engine.hpp>
+#include <gal/geometric_algebra.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Products of vectors in algebras with more than 8 generators, whose blades are identified by 16-bit ids and whose
+// products between basis elements are computed from the generators rather than read from Cayley tables. The 10D metric
+// is that of the double conformal algebra of quadric surfaces, the 9D metric is a conformal algebra of conics in 7D.
+// Building the target reports the peak resident set size of the compiler where GNU time is available (see
+// CMakeLists.txt), which covers reifying the products below.
+
+using namespace gal;
+
+using real_t = double;
+
+template <typename A, size_t... I>
+using vector_entity = entity<A, real_t, (1 << I)...>;
+
+template <typename A, size_t... I>
+void run(char const* name, size_t count, std::index_sequence<I...>)
+{
+    using vector_t             = vector_entity<A, I...>;
+    constexpr auto wedge       = [](auto a, auto b) { return a ^ b; };
+    constexpr auto reflect     = [](auto a, auto n) { return a % n; };
+    using bivector_t           = decltype(compute(wedge, vector_t{}, vector_t{}));
+    using reflected_t          = decltype(compute(reflect, vector_t{}, vector_t{}));
+    constexpr size_t dimension = sizeof...(I);
+    constexpr size_t repetitions = 10;
+
+    std::vector<vector_t> lhs(count);
+    std::vector<vector_t> rhs(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t = static_cast<real_t>(i);
+        lhs[i] = vector_t{std::sin(t + static_cast<real_t>(I))...};
+        rhs[i] = vector_t{std::cos(2 * t + static_cast<real_t>(I))...};
+    }
+
+    std::printf("%s (%zu generators, %zu-bit blade ids)\n", name, dimension, 8 * sizeof(typename A::blade_t));
+
+    std::vector<bivector_t> bivectors(count);
+    double outer = bench::measure(repetitions, [&] {
+        compute_batch(wedge, count, bivectors.data(), lhs.data(), rhs.data());
+        bench::do_not_optimize(bivectors);
+    });
+    bench::report("  outer product", count, outer);
+
+    std::vector<reflected_t> reflected(count);
+    double sandwich = bench::measure(repetitions, [&] {
+        compute_batch(reflect, count, reflected.data(), lhs.data(), rhs.data());
+        bench::do_not_optimize(reflected);
+    });
+    bench::report("  reflection", count, sandwich);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    run<algebra<metric<7, 2, 0>>>("conic", count, std::make_index_sequence<9>{});
+    run<algebra<metric<8, 2, 0>>>("double conformal", count, std::make_index_sequence<10>{});
+    return 0;
+}
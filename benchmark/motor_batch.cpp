@@ -0,0 +1,129 @@
+#include "bench_util.hpp"
+
+#include <gal/pga.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Interpolating the motors of many bones, m(t) = exp(t log(b ~a)) a, is dominated by the exponentials and logarithms.
+// Compares taking them one bone at a time against the batched `exp` and `log` of pga.hpp over bones stored as
+// structure-of-arrays, and against the same batches evaluated with the standard library's transcendentals (calling
+// them once per lane) instead of the approximations of `fp::approx`.
+
+using namespace gal;
+using namespace gal::pga;
+
+using real_t  = float;
+using motor_t = motor<real_t>;
+using line_t  = line<real_t>;
+
+// Structure-of-arrays storage of `count` entities of type T
+template <typename T>
+struct soa_storage
+{
+    std::vector<real_t> components[T::size()];
+
+    explicit soa_storage(size_t count)
+    {
+        for (auto& component : components)
+        {
+            component.resize(count);
+        }
+    }
+
+    [[nodiscard]] soa<T> view() noexcept
+    {
+        soa<T> out;
+        for (size_t k = 0; k != T::size(); ++k)
+        {
+            out.data[k] = components[k].data();
+        }
+        return out;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    constexpr size_t repetitions = 10;
+    size_t bones                 = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+
+    // Reproducible lines with rotations of up to a full turn
+    std::vector<line_t> lines(bones, line_t{0, 0, 0, 0, 0, 0});
+    soa_storage<line_t> line_soa{bones};
+    for (size_t i = 0; i != bones; ++i)
+    {
+        auto t   = static_cast<real_t>(i);
+        lines[i] = line_t{std::sin(t), std::cos(3 * t), 0.5f * std::sin(7 * t), 0.3f, -0.1f * std::cos(t), 0.05f};
+        for (size_t k = 0; k != line_t::size(); ++k)
+        {
+            line_soa.components[k][i] = lines[i][k];
+        }
+    }
+
+    std::vector<motor_t> motors(bones);
+    double serial_exp = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != bones; ++i)
+        {
+            motors[i] = exp(lines[i]);
+        }
+        bench::do_not_optimize(motors);
+    });
+    bench::report("exp (one bone at a time)", bones, serial_exp);
+
+    soa_storage<motor_t> motor_soa{bones};
+    double libm_exp = bench::measure(repetitions, [&] {
+        compute_batch<opt::cse>([](auto l) { return versor_exp(l); }, bones, motor_soa.view(), line_soa.view());
+        bench::do_not_optimize(motor_soa);
+    });
+    bench::report("exp (soa batch, standard library)", bones, libm_exp);
+
+    double batch_exp = bench::measure(repetitions, [&] {
+        exp(bones, motor_soa.view(), line_soa.view());
+        bench::do_not_optimize(motor_soa);
+    });
+    bench::report("exp (soa batch, fp::approx)", bones, batch_exp);
+    std::printf("speedup: %.2fx\n", serial_exp / batch_exp);
+
+    std::vector<line_t> logs(bones, line_t{0, 0, 0, 0, 0, 0});
+    double serial_log = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != bones; ++i)
+        {
+            logs[i] = log(motors[i]);
+        }
+        bench::do_not_optimize(logs);
+    });
+    bench::report("log (one bone at a time)", bones, serial_log);
+
+    soa_storage<line_t> log_soa{bones};
+    double libm_log = bench::measure(repetitions, [&] {
+        compute_batch<opt::cse>([](auto m) { return versor_log(m); }, bones, log_soa.view(), motor_soa.view());
+        bench::do_not_optimize(log_soa);
+    });
+    bench::report("log (soa batch, standard library)", bones, libm_log);
+
+    double batch_log = bench::measure(repetitions, [&] {
+        log(bones, log_soa.view(), motor_soa.view());
+        bench::do_not_optimize(log_soa);
+    });
+    bench::report("log (soa batch, fp::approx)", bones, batch_log);
+    std::printf("speedup: %.2fx\n", serial_log / batch_log);
+
+    // The approximations differ from the standard library by a few units in the last place
+    real_t error = 0;
+    for (size_t i = 0; i != bones; ++i)
+    {
+        for (size_t k = 0; k != motor_t::size(); ++k)
+        {
+            real_t delta = std::abs(motors[i][k] - motor_soa.components[k][i]);
+            error        = delta > error ? delta : error;
+        }
+        for (size_t k = 0; k != line_t::size(); ++k)
+        {
+            real_t delta = std::abs(logs[i][k] - log_soa.components[k][i]);
+            error        = delta > error ? delta : error;
+        }
+    }
+    std::printf("max deviation from one bone at a time: %g\n", error);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "bench_util.hpp"
+
+#include <gal/parallel.hpp>
+#include <gal/pga.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Scaling of `parallel_compute` when transforming a large point cloud by a single motor, from one thread up to the
+// number of hardware threads (or the count passed as the first argument). The single-threaded `compute_batch` time is
+// the baseline for the reported speedups.
+
+using namespace gal;
+using namespace gal::pga;
+
+int main(int argc, char** argv)
+{
+    constexpr size_t count       = 10'000'000;
+    constexpr size_t repetitions = 5;
+
+    size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    max_threads        = max_threads == 0 ? 1 : max_threads;
+
+    std::vector<point<float>> points;
+    points.reserve(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t = static_cast<float>(i);
+        points.emplace_back(std::sin(t), std::cos(t), 0.001f * t);
+    }
+    std::vector<point<float>> out(count, point<float>{0, 0, 0});
+
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    auto sandwich = compile<point<float>, motor<float>>([](auto p, auto m) { return p % m; });
+
+    double baseline = bench::measure(repetitions, [&] {
+        sandwich(count, out.data(), points.data(), m);
+        bench::do_not_optimize(out);
+    });
+    bench::report("compute_batch", count, baseline);
+
+    // Powers of two followed by the maximum
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (size_t threads : thread_counts)
+    {
+        executor ex{threads};
+        double seconds = bench::measure(repetitions, [&] {
+            parallel_compute(ex, sandwich, count, out.data(), points.data(), m);
+            bench::do_not_optimize(out);
+        });
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "parallel_compute (%zu threads)", threads);
+        bench::report(label, count, seconds);
+        std::printf("speedup: %.2fx\n", baseline / seconds);
+    }
+    return 0;
+}
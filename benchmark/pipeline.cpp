@@ -0,0 +1,161 @@
+#include "bench_util.hpp"
+
+#include <gal/cga.hpp>
+#include <gal/pipeline.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using real_t = double;
+
+#include "ga-benchmark/SpecializedAlgorithmInverseKinematics.hpp"
+
+// Solves the inverse kinematics of many robot arms per tick. The serial baseline runs the entire chain of
+// `gabenchmark::InverseKinematics` for one arm after another. The pipeline describes the same chain once as a graph of
+// stages and evaluates each stage as a batch over a cache-sized chunk of arms.
+
+using namespace gal;
+using namespace gal::cga;
+
+using point_t  = point<real_t>;
+using scalar_t = scalar<cga_algebra, real_t>;
+
+// Closed-form exponential of the generator produced by an earlier stage
+template <typename S>
+auto expv(S const& arg)
+{
+    return stage([](auto arg) { return versor_exp(arg); }).after(arg);
+}
+
+auto ik_pipeline()
+{
+    // Robot geometry as in `gabenchmark::InverseKinematics`
+    constexpr int d1 = 200, d2 = 680, d3 = 150, d4 = 140;
+    constexpr int l12 = 890, l23 = 880;
+
+    constant<point_t, d1, 0, d2> J1;
+    constant<point_t, d1, 0, d2 + l12> J2;
+    constant<point_t, d1 + l23, 0, d2 + l12 + d3> J3;
+    rational_constant<point_t, 10, 10 * (d1 + l23 + d4) + 1142, 0, 10 * (d2 + l12 + d3)> Jg;
+    constant<point_t, 0, 0, 1> Pz;
+    constant<point_t, d1, 1, d2> P2_help;
+    constant<point_t, d1, 1, d2 + l12> P3_help;
+    constant<point_t, d1 + l23, 1, d2 + l12 + d3> Pg_help;
+
+    // The joint angles of each arm
+    source<0, scalar_t> ang1;
+    source<1, scalar_t> ang2;
+    source<2, scalar_t> ang3;
+    source<3, scalar_t> ang4;
+    source<4, scalar_t> ang5;
+
+    auto Lz = stage([](auto Pz, auto ang1) {
+                  return frac<1, 2> * ang1 * ((n_o<real_t> ^ Pz ^ n_i<real_t>) >> ips<real_t>);
+              }).after(Pz, ang1);
+    auto R1 = expv(Lz);
+
+    auto L2 = stage([](auto R1, auto J1, auto P2_help, auto ang2) {
+                  auto L2init = (J1 ^ P2_help ^ n_i<real_t>) >> ips<real_t>;
+                  return ang2 * (L2init % R1) / frac<2>;
+              }).after(R1, J1, P2_help, ang2);
+    auto R2 = expv(L2);
+
+    auto R21 = stage([](auto R1, auto R2) { return R2 * R1; }).after(R1, R2);
+    auto J2_f = stage([](auto R21, auto J2) { return J2 % R21; }).after(R21, J2);
+    auto L3   = stage([](auto R21, auto J2, auto P3_help, auto ang3) {
+                  auto L3init = (J2 ^ P3_help ^ n_i<real_t>) >> ips<real_t>;
+                  return frac<1, 2> * ang3 * (L3init % R21);
+              }).after(R21, J2, P3_help, ang3);
+    auto R3 = expv(L3);
+
+    auto t2_help = stage([](auto R1, auto J2, auto J2_f) {
+                       auto J2_rot1 = J2 % R1;
+                       auto t2 = extract<0b1, 0b10, 0b100>{}(J2_f) - extract<0b1, 0b10, 0b100>{}(J2_rot1);
+                       return frac<-1, 2> * t2 ^ n_i<real_t>;
+                   }).after(R1, J2, J2_f);
+    auto T2 = expv(t2_help);
+
+    // The fixed line through J3 and Jg only depends on constants
+    auto L4init = stage([](auto J3, auto Jg) {
+                      auto L4init = (J3 ^ Jg ^ n_i<real_t>) >> ips<real_t>;
+                      return L4init * inv(sqrt(L4init >> ~L4init));
+                  }).after(J3, Jg);
+    auto R3T2R1 = stage([](auto R3, auto T2, auto R1) { return R3 * T2 * R1; }).after(R3, T2, R1);
+    auto L4     = stage([](auto L4init, auto R3T2R1, auto ang4) {
+                  return frac<1, 2> * ang4 * (L4init % R3T2R1);
+              }).after(L4init, R3T2R1, ang4);
+    auto R4 = expv(L4);
+
+    auto Lginit   = stage([](auto J3, auto Pg_help) { return (J3 ^ Pg_help ^ n_i<real_t>) >> ips<real_t>; })
+                      .after(J3, Pg_help);
+    auto R4R3T2R1 = stage([](auto R4, auto R3T2R1) { return R4 * R3T2R1; }).after(R4, R3T2R1);
+    auto Lg       = stage([](auto Lginit, auto R4R3T2R1, auto ang5) {
+                  return frac<1, 2> * ang5 * (Lginit % R4R3T2R1);
+              }).after(Lginit, R4R3T2R1, ang5);
+    auto Rg = expv(Lg);
+
+    auto Rfinal = stage([](auto Rg, auto R4R3T2R1) { return Rg * R4R3T2R1; }).after(Rg, R4R3T2R1);
+    auto Jg_f   = stage([](auto Rfinal, auto Jg) { return Jg % Rfinal; }).after(Rfinal, Jg);
+
+    return make_pipeline(Jg_f);
+}
+
+int main(int argc, char** argv)
+{
+    constexpr size_t repetitions = 10;
+    size_t arms                  = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+
+    std::vector<scalar_t> angles[5];
+    for (size_t i = 0; i != arms; ++i)
+    {
+        auto t = static_cast<real_t>(i) / static_cast<real_t>(arms);
+        angles[0].push_back(scalar_t{0.2 + 0.1 * t});
+        angles[1].push_back(scalar_t{-0.4 + 0.2 * t});
+        angles[2].push_back(scalar_t{0.5 - 0.1 * t});
+        angles[3].push_back(scalar_t{1.1 * t});
+        angles[4].push_back(scalar_t{-0.7 + t});
+    }
+
+    // The serial chain returns the final gripper position of each arm
+    using gripper_t = std::decay_t<decltype(std::get<6>(gabenchmark::InverseKinematics(0.0, 0.0, 0.0, 0.0, 0.0)))>;
+    std::vector<gripper_t> serial(arms);
+
+    double baseline = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != arms; ++i)
+        {
+            serial[i] = std::get<6>(gabenchmark::InverseKinematics(static_cast<real_t>(angles[0][i]),
+                                                                   static_cast<real_t>(angles[1][i]),
+                                                                   static_cast<real_t>(angles[2][i]),
+                                                                   static_cast<real_t>(angles[3][i]),
+                                                                   static_cast<real_t>(angles[4][i])));
+        }
+        bench::do_not_optimize(serial);
+    });
+    bench::report("serial", arms, baseline);
+
+    auto ik = ik_pipeline();
+    executor ex;
+    double pipelined = bench::measure(repetitions, [&] {
+        ik.run(ex, arms, angles[0].data(), angles[1].data(), angles[2].data(), angles[3].data(), angles[4].data());
+        bench::do_not_optimize(ik);
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "pipeline (%zu threads)", ex.thread_count());
+    bench::report(label, arms, pipelined);
+    std::printf("speedup: %.2fx\n", baseline / pipelined);
+
+    // Both evaluate the same polynomials, differing only in rounding
+    auto const* Jg_f = ik.result<0>();
+    real_t error     = 0;
+    for (size_t i = 0; i != arms; ++i)
+    {
+        for (size_t k = 0; k != gripper_t::size(); ++k)
+        {
+            real_t delta = std::abs(serial[i][k] - Jg_f[i].select(gripper_t::elements[k]));
+            error        = delta > error ? delta : error;
+        }
+    }
+    std::printf("max deviation from serial: %g\n", error);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "bench_util.hpp"
+
+#include <gal/pga.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Transforms many points by a single motor. Evaluating the sandwich p % m for every point repeats the products of the
+// motor's coefficients with each other, which are the same for all points. `pga::transform` compiles the motor to a
+// matrix once and then applies it to each point with 9 multiply-adds. Binding the motor of a compiled sandwich kernel
+// derives the same coefficients from the expression itself.
+
+using namespace gal;
+using namespace gal::pga;
+
+using real_t  = float;
+using point_t = point<real_t>;
+
+int main(int argc, char** argv)
+{
+    constexpr size_t repetitions = 10;
+    size_t count                 = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+
+    std::vector<point_t> points(count, point_t{0, 0, 0});
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t    = static_cast<real_t>(i);
+        points[i] = point_t{std::sin(t), std::cos(3 * t), 1e-5f * t};
+    }
+    motor<real_t> m = exp(line<real_t>{0.3f, -0.2f, 0.1f, 0.4f, 0.25f, -0.6f});
+
+    std::vector<point_t> serial(count, point_t{0, 0, 0});
+    double per_point = bench::measure(repetitions, [&] {
+        for (size_t i = 0; i != count; ++i)
+        {
+            serial[i] = compute([](auto p, auto m) { return p % m; }, points[i], m);
+        }
+        bench::do_not_optimize(serial);
+    });
+    bench::report("compute (per point)", count, per_point);
+
+    std::vector<point_t> batched(count, point_t{0, 0, 0});
+    double batch = bench::measure(repetitions, [&] {
+        compute_batch([](auto p, auto m) { return p % m; }, count, batched.data(), points.data(), m);
+        bench::do_not_optimize(batched);
+    });
+    bench::report("compute_batch (motor broadcast)", count, batch);
+
+    // Binding the motor of a compiled kernel splits off the same coefficients generically
+    auto sandwich = compile<point_t, motor<real_t>>([](auto p, auto m) { return p % m; }).bind<1>(m);
+    std::vector<point_t> bound(count, point_t{0, 0, 0});
+    double bind = bench::measure(repetitions, [&] {
+        sandwich(count, bound.data(), points.data());
+        bench::do_not_optimize(bound);
+    });
+    bench::report("kernel bound to the motor", count, bind);
+
+    std::vector<point_t> transformed(count, point_t{0, 0, 0});
+    double matrix = bench::measure(repetitions, [&] {
+        transform(count, transformed.data(), points.data(), m);
+        bench::do_not_optimize(transformed);
+    });
+    bench::report("transform (motor to matrix)", count, matrix);
+    std::printf("speedup: %.2fx over compute, %.2fx over compute_batch\n", per_point / matrix, batch / matrix);
+
+    real_t error = 0;
+    for (size_t i = 0; i != count; ++i)
+    {
+        for (size_t k = 0; k != 3; ++k)
+        {
+            real_t delta = std::abs(serial[i][k] - transformed[i][k]);
+            error        = delta > error ? delta : error;
+        }
+    }
+    std::printf("max deviation from compute: %g\n", error);
+    return 0;
+}
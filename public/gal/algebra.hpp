@@ -4,6 +4,7 @@
 #include "numeric.hpp"
 
 #include <array>
+#include <type_traits>
 
 namespace gal
 {
@@ -28,17 +29,17 @@ struct ind
 
 // The indeterminates that make up a monomial are weakly ordered based on the source identifiers.
 // If all indeterminates are identified (ID != ~0ull), the ordering becomes a total order.
-[[nodiscard]] constexpr bool operator==(ind lhs, ind rhs) noexcept
+[[nodiscard]] constexpr bool operator==(ind const& lhs, ind const& rhs) noexcept
 {
     return lhs.id == rhs.id && lhs.degree == rhs.degree;
 }
 
-[[nodiscard]] constexpr bool operator!=(ind lhs, ind rhs) noexcept
+[[nodiscard]] constexpr bool operator!=(ind const& lhs, ind const& rhs) noexcept
 {
     return lhs.id != rhs.id || lhs.degree != rhs.degree;
 }
 
-[[nodiscard]] constexpr bool operator<(ind lhs, ind rhs) noexcept
+[[nodiscard]] constexpr bool operator<(ind const& lhs, ind const& rhs) noexcept
 {
     return lhs.id < rhs.id || (lhs.id == rhs.id && lhs.degree < rhs.degree);
 }
@@ -60,26 +61,19 @@ struct mon
     width_t ind_offset = 0;
 };
 
-// Temporal structure useful for sorting monomials in place
-struct mon_view
+// Comparisons of the monomials lhs and rhs whose indeterminates start at lhs_inds and rhs_inds. Both are read in place
+// rather than copied, as every copy made during constant evaluation lingers until the evaluation completes.
+[[nodiscard]] constexpr bool mon_equal(mon const& lhs, ind const* lhs_inds, mon const& rhs, ind const* rhs_inds) noexcept
 {
-    mon m;
-    ind* ind_begin = nullptr;
-};
-
-[[nodiscard]] constexpr bool operator==(mon_view const& lhs, mon_view const& rhs) noexcept
-{
-    if (lhs.m.degree != rhs.m.degree || lhs.m.count != rhs.m.count)
+    if (lhs.degree != rhs.degree || lhs.count != rhs.count)
     {
         return false;
     }
     else
     {
-        for (width_t i = 0; i != lhs.m.count; ++i)
+        for (width_t i = 0; i != lhs.count; ++i)
         {
-            auto const& lhs_ind = *(lhs.ind_begin + i);
-            auto const& rhs_ind = *(rhs.ind_begin + i);
-            if (lhs_ind != rhs_ind)
+            if (lhs_inds[i] != rhs_inds[i])
             {
                 return false;
             }
@@ -89,46 +83,33 @@ struct mon_view
     }
 }
 
-[[nodiscard]] constexpr bool operator<(mon_view const& lhs, mon_view const& rhs) noexcept
+[[nodiscard]] constexpr bool mon_less(mon const& lhs, ind const* lhs_inds, mon const& rhs, ind const* rhs_inds) noexcept
 {
-    if (lhs.m.degree < rhs.m.degree)
+    if (lhs.degree < rhs.degree)
     {
         return true;
     }
-    else if (lhs.m.degree > rhs.m.degree)
+    else if (lhs.degree > rhs.degree)
     {
         return false;
     }
     else
     {
-        auto min_ind = std::min(lhs.m.count, rhs.m.count);
+        auto min_ind = std::min(lhs.count, rhs.count);
         for (width_t i = 0; i != min_ind; ++i)
         {
-            auto const& lhs_ind = *(lhs.ind_begin + i);
-            auto const& rhs_ind = *(rhs.ind_begin + i);
-            if (lhs_ind < rhs_ind)
+            if (lhs_inds[i] < rhs_inds[i])
             {
                 return true;
             }
-            else if (rhs_ind < lhs_ind)
+            else if (rhs_inds[i] < lhs_inds[i])
             {
                 return false;
             }
         }
 
-        if (lhs.m.count == rhs.m.count)
-        {
-            // The monomials compare exactly equal
-            return false;
-        }
-        else if (min_ind == lhs.m.count)
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        // Monomials which compare exactly equal are not less
+        return lhs.count != rhs.count && min_ind == lhs.count;
     }
 }
 
@@ -478,7 +459,7 @@ struct mv
     std::array<term, T> terms;
 
     // Push a term onto this multivector with a scaling factor and change of element
-    constexpr void push(const_term_it it, rat scale, uint8_t e) noexcept
+    constexpr void push(const_term_it it, rat scale, uint32_t e) noexcept
     {
         auto out_mons_it = mons.begin() + size.mon;
 
@@ -606,6 +587,23 @@ struct mv
 
 namespace detail
 {
+    // The type identifying the basis blades of algebra A. Without an algebra (A = void) blades are identified by the
+    // full width of a term's element.
+    template <typename A, typename = void>
+    struct blade_of
+    {
+        using type = uint32_t;
+    };
+
+    template <typename A>
+    struct blade_of<A, std::void_t<typename A::blade_t>>
+    {
+        using type = typename A::blade_t;
+    };
+
+    template <typename A>
+    using blade_t = typename blade_of<A>::type;
+
     template <typename T1, typename T2>
     [[nodiscard]] constexpr auto sum(T1 const& lhs, T2 const& rhs) noexcept
     {
@@ -867,7 +865,7 @@ namespace detail
         return in;
     }
 
-    [[nodiscard]] constexpr std::pair<uint32_t, int> poincare_complement(uint8_t element, uint8_t dim) noexcept
+    [[nodiscard]] constexpr std::pair<uint32_t, int> poincare_complement(uint32_t element, uint32_t dim) noexcept
     {
         uint32_t complement = ((1 << dim) - 1) ^ element;
 
@@ -889,10 +887,51 @@ namespace detail
         return {complement, swaps % 2 == 0 ? 1 : -1};
     }
 
-    [[nodiscard]] constexpr auto collate(term* const start,
-                                         term* const end,
-                                         mon_view* const mon_start,
-                                         ind* const ind_start,
+    // The counting sort of terms keeps two counters per basis element
+    constexpr inline size_t counting_sort_max_dimension = 12;
+
+    // Sorts terms by element. Long lists (such as the term pairs of a product, which repeat the same few elements) are
+    // counting sorted with a bucket per basis element. Lists for which the buckets cost more than the expected n^2 / 4
+    // steps of an insertion sort are insertion sorted instead. Without an algebra (A = void) the elements are not
+    // bounded and a comparison sort is used, as it is for algebras with too many basis elements to allot a bucket each.
+    template <typename A>
+    constexpr void sort_terms(term* first, term* last) noexcept
+    {
+        if constexpr (std::is_void_v<A>)
+        {
+            sort(first, last);
+        }
+        else if constexpr (A::metric_t::dimension > counting_sort_max_dimension)
+        {
+            sort(first, last);
+        }
+        else
+        {
+            constexpr size_t element_count = size_t{1} << A::metric_t::dimension;
+            auto count                     = static_cast<size_t>(last - first);
+            if (count * count < 4 * element_count)
+            {
+                insertion_sort(first, last, [](term const& lhs, term const& rhs) { return lhs < rhs; });
+            }
+            else
+            {
+                counting_sort<element_count>(first, last, [](term const& t) { return t.element; });
+            }
+        }
+    }
+
+    // Merges terms of the same element and the coincident monomials within them, dropping those which cancel. The
+    // input terms must be sorted by element. The `scratch` storage is used to sort the positions of the monomials of
+    // each element and must have room for one and a half times as many positions as there are input monomials.
+    //
+    // Monomials are ordered through their positions and written to the output once they are merged. Moving the
+    // monomials themselves copies them on every pass of the sort, and every copy made during constant evaluation
+    // lingers until the evaluation completes.
+    [[nodiscard]] constexpr auto collate(term const* const start,
+                                         term const* const end,
+                                         mon const* const mon_start,
+                                         ind const* const ind_start,
+                                         width_t* const scratch,
                                          term* out_terms_it,
                                          mon* out_mons_it,
                                          ind* out_inds_it,
@@ -904,45 +943,38 @@ namespace detail
         // We need to collate terms that refer to the same element together into one
         for (auto term_it = start; term_it != end;)
         {
-            auto mon_cursor = out_mons_it;
+            auto order_end = scratch;
 
             auto next = term_it;
-            for (; next != end; ++next)
+            for (; next != end && next->element == term_it->element; ++next)
             {
-                if (next->element == term_it->element)
-                {
-                    for (auto mon_it = mon_start + next->mon_offset; mon_it != mon_start + next->mon_offset + next->count;
-                         ++mon_it)
-                    {
-                        *out_mons_it++ = mon_it->m;
-                    }
-                }
-                else
+                for (width_t i = next->mon_offset; i != next->mon_offset + next->count; ++i)
                 {
-                    // Non-collatable term
-                    break;
+                    *order_end++ = i;
                 }
             }
 
             // Now, the monomials need to be sorted and collated
-            sort(mon_cursor, out_mons_it, [ind_begin = ind_start](auto&& lhs, auto&& rhs) {
-                return mon_view{lhs, ind_begin + lhs.ind_offset} < mon_view{rhs, ind_begin + rhs.ind_offset};
+            merge_sort(scratch, order_end, order_end, [mon_start, ind_start](width_t lhs, width_t rhs) {
+                auto const& lhs_mon = mon_start[lhs];
+                auto const& rhs_mon = mon_start[rhs];
+                return mon_less(lhs_mon, ind_start + lhs_mon.ind_offset, rhs_mon, ind_start + rhs_mon.ind_offset);
             });
 
-            // We *overwrite* monomials in the final output as we collate them (conserves memory)
-            auto mon_writer = mon_cursor;
-
-            for (auto mon_it = mon_cursor; mon_it != out_mons_it;)
+            auto mon_cursor = out_mons_it;
+            for (auto order_it = scratch; order_it != order_end;)
             {
-                rat q         = mon_it->q;
-                auto next_mon = mon_it + 1;
-                mon_view current_mon{*mon_it, ind_start + mon_it->ind_offset};
-                for (; next_mon != out_mons_it; ++next_mon)
+                auto const& current = mon_start[*order_it];
+                auto const* inds    = ind_start + current.ind_offset;
+                rat q               = current.q;
+                auto order_next     = order_it + 1;
+                for (; order_next != order_end; ++order_next)
                 {
-                    if (current_mon == mon_view{*next_mon, ind_start + next_mon->ind_offset})
+                    auto const& next_mon = mon_start[*order_next];
+                    if (mon_equal(current, inds, next_mon, ind_start + next_mon.ind_offset))
                     {
                         // Coincident monomials need to be added together
-                        q = q + next_mon->q;
+                        q = q + next_mon.q;
                     }
                     else
                     {
@@ -953,28 +985,24 @@ namespace detail
 
                 if (!q.is_zero())
                 {
-                    // CAREFUL! The mon_writer above may overwrite what mon_it points to
-                    *mon_writer++
-                        = mon{q, mon_it->degree, mon_it->count, static_cast<width_t>(out_inds_it - out_inds_begin)};
+                    *out_mons_it++
+                        = mon{q, current.degree, current.count, static_cast<width_t>(out_inds_it - out_inds_begin)};
 
                     // Copy over indeterminates referenced by the monomial
-                    for (auto ind_it = ind_start + current_mon.m.ind_offset;
-                         ind_it != ind_start + current_mon.m.ind_offset + mon_it->count;
-                         ++ind_it)
+                    for (auto ind_it = inds; ind_it != inds + current.count; ++ind_it)
                     {
                         *out_inds_it++ = *ind_it;
                     }
                 }
 
-                mon_it = next_mon;
+                order_it = order_next;
             }
 
-            width_t mon_count = static_cast<width_t>(mon_writer - mon_cursor);
+            width_t mon_count = static_cast<width_t>(out_mons_it - mon_cursor);
             if (mon_count > 0)
             {
                 *out_terms_it++ = term{mon_count, static_cast<width_t>(mon_cursor - out_mons_begin), term_it->element};
             }
-            out_mons_it = mon_writer;
             // Set the iterator to the term after a repeated sequence of terms of the same element.
             term_it = next;
         }
@@ -1013,19 +1041,94 @@ namespace detail
             }
         }
 
-        std::array<mon_view, T::mon_capacity()> mon_views;
-        for (width_t i = 0; i != out.size.mon; ++i)
+        // The complement of each element reverses the order of the (sorted and distinct) input elements exactly
+        for (auto lhs = out.terms.begin(), rhs = out.terms.begin() + out.size.term; lhs < rhs--; ++lhs)
+        {
+            swap(*lhs, *rhs);
+        }
+
+        std::array<width_t, T::mon_capacity() + T::mon_capacity() / 2> scratch{};
+        T collated{};
+        collate(out.terms.begin(),
+                out.terms.begin() + out.size.term,
+                out.mons.begin(),
+                out.inds.begin(),
+                scratch.begin(),
+                collated.terms.begin(),
+                collated.mons.begin(),
+                collated.inds.begin(),
+                collated.size);
+        return collated;
+    }
+
+    // The partial derivative of the polynomials of `in` with respect to the indeterminate `id`. The exponent of the
+    // indeterminate is brought down into the coefficient of each monomial containing it and the others vanish. Lowering
+    // the exponent does not preserve the graded lexicographic order, so the monomials are collated again afterwards.
+    template <typename T>
+    [[nodiscard]] constexpr auto differentiate(T const& in, width_t id) noexcept
+    {
+        T out{};
+
+        auto out_term_it = out.terms.begin();
+        auto out_mon_it  = out.mons.begin();
+        auto out_ind_it  = out.inds.begin();
+
+        for (auto it = in.cbegin(); it != in.cend(); ++it)
         {
-            mon_views[i] = mon_view{out.mons[i], out.inds.begin()};
+            auto mon_cursor = out_mon_it;
+            for (auto mon_it = it.cbegin(); mon_it != it.cend(); ++mon_it)
+            {
+                rat degree = zero;
+                for (auto ind_it = mon_it.cbegin(); ind_it != mon_it.cend(); ++ind_it)
+                {
+                    if (ind_it->id == id)
+                    {
+                        degree = ind_it->degree;
+                    }
+                }
+
+                if (degree.is_zero())
+                {
+                    continue;
+                }
+
+                auto ind_cursor = out_ind_it;
+                for (auto ind_it = mon_it.cbegin(); ind_it != mon_it.cend(); ++ind_it)
+                {
+                    if (ind_it->id != id)
+                    {
+                        *out_ind_it++ = *ind_it;
+                    }
+                    else if (degree != one)
+                    {
+                        *out_ind_it++ = ind{id, degree - one};
+                    }
+                }
+                *out_mon_it++ = mon{mon_it->q * degree,
+                                    mon_it->degree - one,
+                                    static_cast<width_t>(out_ind_it - ind_cursor),
+                                    static_cast<width_t>(ind_cursor - out.inds.begin())};
+            }
+
+            if (out_mon_it != mon_cursor)
+            {
+                *out_term_it++ = term{static_cast<width_t>(out_mon_it - mon_cursor),
+                                      static_cast<width_t>(mon_cursor - out.mons.begin()),
+                                      it->element};
+            }
         }
 
-        sort(out.terms.begin(), out.terms.begin() + out.size.term);
+        out.size = mv_size{static_cast<width_t>(out_ind_it - out.inds.begin()),
+                           static_cast<width_t>(out_mon_it - out.mons.begin()),
+                           static_cast<width_t>(out_term_it - out.terms.begin())};
 
+        std::array<width_t, T::mon_capacity() + T::mon_capacity() / 2> scratch{};
         T collated{};
         collate(out.terms.begin(),
                 out.terms.begin() + out.size.term,
-                mon_views.begin(),
+                out.mons.begin(),
                 out.inds.begin(),
+                scratch.begin(),
                 collated.terms.begin(),
                 collated.mons.begin(),
                 collated.inds.begin(),
@@ -1051,7 +1154,7 @@ namespace detail
         // The monomials and indeterminates start out unsorted so we place them in temporary storage first before the
         // final sort-on-copy.
         std::array<ind, ind_size> temp_inds;
-        std::array<mon_view, mon_size> temp_mons;
+        std::array<mon, mon_size> temp_mons;
         std::array<term, term_size> temp_terms;
         auto temp_inds_it  = temp_inds.begin();
         auto temp_mons_it  = temp_mons.begin();
@@ -1110,7 +1213,9 @@ namespace detail
                                         degree += next_degree;
                                         if (next_degree != 0)
                                         {
-                                            // TODO: handle dual numbers
+                                            // Indeterminates whose exponents cancel drop out of the monomial.
+                                            // Derivatives are taken symbolically (see `differentiate`) rather than
+                                            // by carrying dual numbers through the product.
                                             *temp_inds_it++ = ind{lhs_ind.id, next_degree};
                                         }
                                         ++lhs_ind_it;
@@ -1131,11 +1236,10 @@ namespace detail
                                 }
                             }
 
-                            *temp_mons_it++ = mon_view{mon{rat{multiplier * lhs_mon->q * rhs_mon->q},
-                                                           degree,
-                                                           static_cast<width_t>(temp_inds_it - ind_cursor),
-                                                           static_cast<width_t>(ind_cursor - temp_inds.begin())},
-                                                       ind_cursor};
+                            *temp_mons_it++ = mon{rat{multiplier * lhs_mon->q * rhs_mon->q},
+                                                  degree,
+                                                  static_cast<width_t>(temp_inds_it - ind_cursor),
+                                                  static_cast<width_t>(ind_cursor - temp_inds.begin())};
                         }
                     }
 
@@ -1146,13 +1250,15 @@ namespace detail
         }
 
         // The product between terms is not necessarily order-preserving so we need to both sort terms and monomials
-        sort(temp_terms.begin(), temp_terms_it);
+        sort_terms<typename T1::algebra_t>(temp_terms.begin(), temp_terms_it);
 
+        std::array<width_t, mon_size + mon_size / 2> scratch{};
         mv<typename T1::algebra_t, ind_size, mon_size, term_size> out{};
         collate(temp_terms.begin(),
                 temp_terms_it,
                 temp_mons.begin(),
                 temp_inds.begin(),
+                scratch.begin(),
                 out.terms.begin(),
                 out.mons.begin(),
                 out.inds.begin(),
@@ -1161,7 +1267,7 @@ namespace detail
     }
 
     template <typename A, width_t I, width_t M, width_t T, size_t N>
-    [[nodiscard]] constexpr auto extract(mv<A, I, M, T> const& in, std::array<uint8_t, N> const& elements) noexcept
+    [[nodiscard]] constexpr auto extract(mv<A, I, M, T> const& in, std::array<uint32_t, N> const& elements) noexcept
     {
         mv<A, I, M, N> out{};
         auto element = elements.begin();
@@ -1188,6 +1294,21 @@ namespace detail
             }
         }
     }
+
+    // The terms of the given grade
+    template <typename A, width_t I, width_t M, width_t T>
+    [[nodiscard]] constexpr auto select(mv<A, I, M, T> const& in, uint32_t grade) noexcept
+    {
+        mv<A, I, M, T> out{};
+        for (auto term = in.cbegin(); term != in.cend(); ++term)
+        {
+            if (pop_count(term->element) == grade)
+            {
+                out.push(term, one, term->element);
+            }
+        }
+        return out;
+    }
 } // namespace detail
 
 // Convenience template variable for making basis elements
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 namespace gal
 {
@@ -19,160 +20,183 @@ namespace detail
         rhs = tmp;
     }
 
-    // Needed for the time being because std::sort is not yet declared constexpr
-    template <typename T>
-    constexpr void sort(T first, T last) noexcept
+    // Straight insertion sort. Linear for input which is already (nearly) sorted and the fastest option for short
+    // ranges, so it also serves as the base case of the sorts below.
+    template <typename T, typename L>
+    constexpr void insertion_sort(T first, T last, L&& less) noexcept
     {
         if (last - first < 2)
         {
-            // Don't bother sorting an empty or single element range
             return;
         }
-        else if (last - first < 3)
+
+        for (auto it = first + 1; it != last; ++it)
         {
-            if (*(first + 1) < *first)
+            if (!less(*it, *(it - 1)))
             {
-                swap(*first, *(first + 1));
+                continue;
             }
+
+            auto value  = *it;
+            auto cursor = it;
+            do
+            {
+                *cursor = *(cursor - 1);
+                --cursor;
+            } while (cursor != first && less(value, *(cursor - 1)));
+            *cursor = value;
+        }
+    }
+
+    // Stable merge sort. The `buffer` must have room for half of the range (rounded down). Halves which are already in
+    // order are detected with a single comparison and left alone, so sorted input costs n - 1 comparisons and no moves.
+    // Intended for elements which are expensive to compare (monomials), for which the number of comparisons dominates.
+    template <typename T, typename B, typename L>
+    constexpr void merge_sort(T first, T last, B buffer, L&& less) noexcept
+    {
+        if (last - first <= 8)
+        {
+            insertion_sort(first, last, less);
+            return;
+        }
+
+        auto mid = first + (last - first) / 2;
+        merge_sort(first, mid, buffer, less);
+        merge_sort(mid, last, buffer, less);
+
+        if (!less(*mid, *(mid - 1)))
+        {
+            return;
+        }
+
+        // Move the lhs out of the way and merge both halves back into place. The output never overtakes the unread
+        // part of the rhs.
+        auto buffer_end = buffer;
+        for (auto it = first; it != mid; ++it)
+        {
+            *buffer_end++ = *it;
         }
-        else if (last - first < 4)
+
+        auto lhs = buffer;
+        auto rhs = mid;
+        auto out = first;
+        while (lhs != buffer_end && rhs != last)
         {
-            // For a short 3 element run, do a few quick comparisons and swaps to terminate sooner
-            if (*(first + 1) < *first)
+            if (less(*rhs, *lhs))
             {
-                if (*(first + 2) < *first)
-                {
-                    if (*(first + 2) < *(first + 1))
-                    {
-                        // 3 2 1
-                        swap(*first, *(first + 2));
-                    }
-                    else
-                    {
-                        // 3 1 2
-                        swap(*first, *(first + 1));
-                        swap(*(first + 1), *(first + 2));
-                    }
-                }
-                else
-                {
-                    // 2 1 3
-                    swap(*first, *(first + 1));
-                }
+                *out++ = *rhs++;
             }
             else
             {
-                if (*(first + 2) < *first)
-                {
-                    // 2 3 1
-                    swap(*first, *(first + 1));
-                    swap(*first, *(first + 2));
-                }
-                else
-                {
-                    if (*(first + 2) < *(first + 1))
-                    {
-                        // 1 3 2
-                        swap(*(first + 1), *(first + 2));
-                    }
-                }
+                *out++ = *lhs++;
             }
         }
-        else
+
+        while (lhs != buffer_end)
         {
-            // NOTE: This is NOT the most efficient qsort implementation but it is implemented this way for simplicity.
-            // If it is a bottleneck, a faster sort will be implemented in the future. Use the last as the pivot
-            auto pivot = *(last - 1);
-            auto cursor = first;
-            for (auto it = first; it != last - 1; ++it)
-            {
-                if (*it < pivot)
-                {
-                    swap(*cursor++, *it);
-                }
-            }
-            swap(*(last - 1), *cursor);
-            sort(first, cursor);
-            sort(cursor + 1, last);
+            *out++ = *lhs++;
         }
     }
 
-    // The third argument is a comparator
-    template <typename T, typename L>
-    constexpr void sort(T first, T last, L&& less) noexcept
+    // In-place counting sort of a range whose keys are integers within [0, K) (an "American flag" sort). Each element
+    // is swapped directly into the bucket of its key, so the cost is O(n + K) regardless of the order of the input.
+    // The sort is not stable.
+    template <size_t K, typename T, typename F>
+    constexpr void counting_sort(T first, T last, F&& key) noexcept
     {
-        if (last - first < 2)
+        std::array<size_t, K> begin{};
+        std::array<size_t, K> end{};
+        for (auto it = first; it != last; ++it)
         {
-            // Don't bother sorting an empty or single element range
-            return;
+            ++end[key(*it)];
         }
-        else if (last - first < 3)
+
+        size_t offset = 0;
+        for (size_t k = 0; k != K; ++k)
         {
-            if (less(*(first + 1), *first))
-            {
-                swap(*first, *(first + 1));
-            }
+            begin[k] = offset;
+            offset += end[k];
+            end[k] = offset;
         }
-        else if (last - first < 4)
+
+        for (size_t k = 0; k != K; ++k)
         {
-            // For a short 3 element run, do a few quick comparisons and swaps to terminate sooner
-            if (less(*(first + 1), *first))
+            while (begin[k] != end[k])
             {
-                if (less(*(first + 2), *first))
+                auto target = static_cast<size_t>(key(*(first + begin[k])));
+                if (target == k)
                 {
-                    if (less(*(first + 2), *(first + 1)))
-                    {
-                        // 3 2 1
-                        swap(*first, *(first + 2));
-                    }
-                    else
-                    {
-                        // 3 1 2
-                        swap(*first, *(first + 1));
-                        swap(*(first + 1), *(first + 2));
-                    }
+                    ++begin[k];
                 }
                 else
                 {
-                    // 2 1 3
-                    swap(*first, *(first + 1));
+                    swap(*(first + begin[k]), *(first + begin[target]++));
                 }
             }
-            else
+        }
+    }
+
+    // Non-recursive heap sort with a guaranteed O(n log n) bound regardless of the input order, and no scratch storage
+    // or recursion (so no risk of exceeding the constexpr recursion depth).
+    template <typename T, typename L>
+    constexpr void heap_sort(T first, T last, L&& less) noexcept
+    {
+        auto count = last - first;
+
+        // Restores the max-heap property for the subtree rooted at root within the first `end` elements
+        auto sift_down = [&](decltype(count) root, decltype(count) end) {
+            while (true)
             {
-                if (less(*(first + 2), *first))
+                auto child = 2 * root + 1;
+                if (child >= end)
                 {
-                    // 2 3 1
-                    swap(*first, *(first + 1));
-                    swap(*first, *(first + 2));
+                    return;
                 }
-                else
+                if (child + 1 < end && less(*(first + child), *(first + child + 1)))
                 {
-                    if (less(*(first + 2), *(first + 1)))
-                    {
-                        // 1 3 2
-                        swap(*(first + 1), *(first + 2));
-                    }
+                    ++child;
                 }
+                if (!less(*(first + root), *(first + child)))
+                {
+                    return;
+                }
+                swap(*(first + root), *(first + child));
+                root = child;
             }
+        };
+
+        for (auto i = count / 2; i-- > 0;)
+        {
+            sift_down(i, count);
+        }
+
+        for (auto end = count; end > 1;)
+        {
+            --end;
+            swap(*first, *(first + end));
+            sift_down(0, end);
+        }
+    }
+
+    // Needed for the time being because std::sort is not yet declared constexpr. Short ranges are insertion sorted and
+    // longer ones heap sorted, which is O(n log n) even for the (nearly) sorted input common here.
+    template <typename T, typename L>
+    constexpr void sort(T first, T last, L&& less) noexcept
+    {
+        if (last - first <= 16)
+        {
+            insertion_sort(first, last, less);
         }
         else
         {
-            // NOTE: This is NOT the most efficient qsort implementation but it is implemented this way for simplicity.
-            // If it is a bottleneck, a faster sort will be implemented in the future. Use the last as the pivot
-            auto pivot = *(last - 1);
-            auto cursor = first;
-            for (auto it = first; it != last - 1; ++it)
-            {
-                if (less(*it, pivot))
-                {
-                    swap(*cursor++, *it);
-                }
-            }
-            swap(*(last - 1), *cursor);
-            sort(first, cursor, less);
-            sort(cursor + 1, last, less);
+            heap_sort(first, last, less);
         }
     }
+
+    template <typename T>
+    constexpr void sort(T first, T last) noexcept
+    {
+        sort(first, last, [](auto const& lhs, auto const& rhs) { return lhs < rhs; });
+    }
 }
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// Branch-free approximations of the transcendental functions used by staged scalar operations. The standard library
+// functions are opaque calls (and `std::sqrt` must preserve `errno`), which confines batch evaluation to one lane at a
+// time whenever a kernel needs them. The functions here are straight-line arithmetic with blends in place of branches,
+// so loops over lanes calling them vectorize like the rest of a batch. They are selected by the `fp::approx` policy.
+// (The double precision atan2 compares 64-bit integers, which x86 vectorizes from SSE4.2 onwards.)
+//
+// The maximum errors measured against the exact result (see test_approx.cpp) are
+//
+//     function        float                       double
+//     sin, cos        1.6 ulp for |x| <= 2^20     1.6 ulp for |x| <= 2^20
+//     atan2           2.5 ulp                     1.6 ulp
+//     sqrt            1 ulp                       1 ulp
+//
+// The range reduction of sin and cos loses accuracy gradually beyond the ranges given. None of the functions handle
+// infinities or NaNs and sqrt expects non-negative finite inputs.
+
+namespace gal
+{
+namespace approx
+{
+    namespace detail
+    {
+        template <typename T>
+        using bits_t = std::conditional_t<std::is_same_v<T, float>, uint32_t, uint64_t>;
+
+        template <typename To, typename From>
+        [[nodiscard]] inline To bit_cast(From from) noexcept
+        {
+            static_assert(sizeof(To) == sizeof(From));
+            return __builtin_bit_cast(To, from);
+        }
+
+        // `condition ? a : b` as a bitwise blend. Floating point comparisons may raise exceptions and the compiler
+        // only blends values computed on both sides of a condition where that cannot trap, so conditions are evaluated
+        // on the bit patterns (which order like the values for non-negative numbers) and merged with masks.
+        template <typename T>
+        [[nodiscard]] inline T select(bool condition, T a, T b) noexcept
+        {
+            using bits = bits_t<T>;
+            auto mask  = bits{0} - static_cast<bits>(condition);
+            return bit_cast<T>(static_cast<bits>((bit_cast<bits>(a) & mask) | (bit_cast<bits>(b) & ~mask)));
+        }
+
+        // Round to the nearest integer by pushing the fraction out of the mantissa. Valid for |x| < 2^22 (float) or
+        // 2^51 (double).
+        template <typename T>
+        [[nodiscard]] inline T round_nearest(T x) noexcept
+        {
+            constexpr T shift = std::is_same_v<T, float> ? T{12582912.f} : T{6755399441055744.0};
+            return (x + shift) - shift;
+        }
+    } // namespace detail
+
+    // The sine and cosine of x, sharing the range reduction
+    template <typename T>
+    inline void sincos(T x, T& s, T& c) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "Approximations are provided for float and double only.");
+
+        // Reduce x to r in [-pi/4, pi/4] with x = r + q * pi/2, subtracting pi/2 in parts whose products with q are
+        // exact (Cody and Waite). The reduction for floats is carried out in double precision.
+        T q;
+        T r;
+        T z;
+        T sin_r;
+        T cos_r;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            auto xd = static_cast<double>(x);
+            auto qd = detail::round_nearest(xd * 0.636619772367581343076);
+            q       = static_cast<float>(qd);
+            r       = static_cast<float>((xd - qd * 1.57079632673412561417) - qd * 6.07710050650619224932e-11);
+            z       = r * r;
+
+            // Minimax polynomials on [-pi/4, pi/4] (Cephes)
+            sin_r = r + r * z * ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f);
+            cos_r = 1.f - 0.5f * z
+                    + z * z * ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f);
+        }
+        else
+        {
+            q = detail::round_nearest(x * 0.636619772367581343076);
+            r = ((x - q * 1.57079625129699707031) - q * 7.54978941586159635335e-8) - q * 5.39030285815811905290e-15;
+            z = r * r;
+
+            sin_r = r
+                    + r * z
+                          * (((((1.58962301576546568060e-10 * z - 2.50507477628578072866e-8) * z
+                                + 2.75573136213857245213e-6)
+                                   * z
+                               - 1.98412698295895385996e-4)
+                                  * z
+                              + 8.33333333332211858878e-3)
+                                 * z
+                             - 1.66666666666666307295e-1);
+            cos_r = 1.0 - 0.5 * z
+                    + z * z
+                          * (((((-1.13585365213876817300e-11 * z + 2.08757008419747316778e-9) * z
+                                - 2.75573141792967388112e-7)
+                                   * z
+                               + 2.48015872888517045348e-5)
+                                  * z
+                              - 1.38888888888730564116e-3)
+                                 * z
+                             + 4.16666666666665929218e-2);
+        }
+
+        // Rotate by the quadrant: sin(x) is one of {s, c, -s, -c} and cos(x) one of {c, -s, -c, s}
+        using bits_t        = detail::bits_t<T>;
+        constexpr int shift = 8 * sizeof(T) - 2;
+        auto quadrant       = static_cast<bits_t>(static_cast<uint32_t>(static_cast<int32_t>(q)));
+        bool odd            = (quadrant & 1) != 0;
+        T sin_q             = detail::select(odd, cos_r, sin_r);
+        T cos_q             = detail::select(odd, sin_r, cos_r);
+        bits_t sin_sign     = (quadrant & 2) << shift;
+        bits_t cos_sign     = ((quadrant + 1) & 2) << shift;
+        s                   = detail::bit_cast<T>(static_cast<bits_t>(detail::bit_cast<bits_t>(sin_q) ^ sin_sign));
+        c                   = detail::bit_cast<T>(static_cast<bits_t>(detail::bit_cast<bits_t>(cos_q) ^ cos_sign));
+    }
+
+    template <typename T>
+    [[nodiscard]] inline T sin(T x) noexcept
+    {
+        T s;
+        T c;
+        sincos(x, s, c);
+        return s;
+    }
+
+    template <typename T>
+    [[nodiscard]] inline T cos(T x) noexcept
+    {
+        T s;
+        T c;
+        sincos(x, s, c);
+        return c;
+    }
+
+    // The angle of the point (x, y), as with std::atan2
+    template <typename T>
+    [[nodiscard]] inline T atan2(T y, T x) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "Approximations are provided for float and double only.");
+        using bits_t = detail::bits_t<T>;
+
+        // Pi/2 and pi/4 split into their nearest representable value and the remainder
+        constexpr T pi_2    = T{1.57079632679489661923};
+        constexpr T pi_4    = T{0.785398163397448309616};
+        constexpr T pi_2_lo = std::is_same_v<T, float> ? T{-4.37113900e-8f} : T{6.123233995736765886130e-17};
+
+        // Fold the point into the first octant so that the ratio a lies within [0, 1]
+        T ax      = std::abs(x);
+        T ay      = std::abs(y);
+        bool swap = detail::bit_cast<bits_t>(ay) > detail::bit_cast<bits_t>(ax);
+        T num     = detail::select(swap, ax, ay);
+        T den     = detail::select(swap, ay, ax);
+        T a       = num / detail::select(detail::bit_cast<bits_t>(den) == 0, T{1}, den);
+
+        // Above the threshold, a is shifted down by pi/4 to the range of the approximation
+        constexpr T threshold = std::is_same_v<T, float> ? T{0.414213562373095f} : T{0.66};
+        bool upper            = detail::bit_cast<bits_t>(a) > detail::bit_cast<bits_t>(threshold);
+        T shifted             = (a - T{1}) / (a + T{1});
+        T t                   = detail::select(upper, shifted, a);
+        T z                   = t * t;
+
+        T r;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            // Minimax polynomial for [0, tan(pi/8)] (Cephes)
+            r = t
+                + t * z
+                      * (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f);
+        }
+        else
+        {
+            // Rational approximation for [0, 0.66] (Cephes)
+            T p = -8.750608600031904122785e-1;
+            p   = p * z - 1.615753718733365076637e1;
+            p   = p * z - 7.500855792314704667340e1;
+            p   = p * z - 1.228866684490136173410e2;
+            p   = p * z - 6.485021904942025371773e1;
+            T q = z + 2.485846490142306297962e1;
+            q   = q * z + 1.650270098316988542046e2;
+            q   = q * z + 4.328810604912902668951e2;
+            q   = q * z + 4.853903996359136964868e2;
+            q   = q * z + 1.945506571482613964425e2;
+            r   = t + t * z * p / q;
+        }
+        T offset = detail::select(upper, pi_4, T{0});
+        T lo     = detail::select(upper, T{0.5} * pi_2_lo, T{0});
+        r        = offset + (r + lo);
+
+        // Unfold the octant
+        T reflected = (pi_2 - r) + pi_2_lo;
+        r           = detail::select(swap, reflected, r);
+        T mirrored  = (T{2} * pi_2 - r) + T{2} * pi_2_lo;
+        r           = detail::select((detail::bit_cast<bits_t>(x) >> (8 * sizeof(T) - 1)) != 0, mirrored, r);
+        return std::copysign(r, y);
+    }
+
+    // The square root of a non-negative x via Newton iterations on the reciprocal square root
+    template <typename T>
+    [[nodiscard]] inline T sqrt(T x) noexcept
+    {
+        static_assert(std::is_floating_point_v<T>, "Approximations are provided for float and double only.");
+        using bits_t = detail::bits_t<T>;
+
+        // The initial estimate is within 3.5% (Lomont) and each iteration squares the relative error
+        constexpr auto magic = static_cast<bits_t>(std::is_same_v<T, float> ? 0x5f375a86ull : 0x5fe6eb50c7b537a9ull);
+        constexpr int iterations = std::is_same_v<T, float> ? 3 : 4;
+
+        T y = detail::bit_cast<T>(static_cast<bits_t>(magic - (detail::bit_cast<bits_t>(x) >> 1)));
+        for (int i = 0; i != iterations; ++i)
+        {
+            y = y * (T{1.5} - T{0.5} * x * y * y);
+        }
+
+        // A final correction of the square root itself recovers the last bit
+        T s = x * y;
+        return s + T{0.5} * y * (x - s * s);
+    }
+} // namespace approx
+} // namespace gal
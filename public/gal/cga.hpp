@@ -21,6 +21,10 @@ namespace cga
     // The CGA is a graded algebra with 32 basis elements
     using cga_algebra = gal::algebra<cga_metric>;
 
+    // The closed forms of `versor_exp` and `versor_log` cover rotations, translations and their compositions. The
+    // generators of dilations (e.g. n_o ^ n_i), boosts and transversions square to a positive scalar and are not
+    // supported: they evaluate to NaN, which is reported in builds defining GAL_DEBUG.
+
     // 0b1 => e+ extension
     // 0b10000 => e- extension
     namespace detail
@@ -126,7 +130,7 @@ namespace cga
             , z{c}
         {}
 
-        template <uint8_t... E>
+        template <typename algebra_t::blade_t... E>
         constexpr point(entity<algebra_t, T, E...> in) noexcept
             : data{in.template select<0b1, 0b10, 0b100>()}
         {}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "engine.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Forward-mode differentiation of kernels. `diff<I, C>(lambda)` is a lambda whose result is the partial derivative of
+// the result of `lambda` with respect to component C of its I-th input. The derivative is taken symbolically on the
+// expression template before it is reified: the indeterminate tables of the leaves are differentiated exactly (see
+// `detail::differentiate`) and the product and chain rules are applied to the operations above them. The derivative is
+// then an ordinary expression, so it is reified, staged and compiled like any other, and passing it to `compute`
+// yields exact derivatives from a single kernel. Branches whose derivative vanishes are pruned before reification, so
+// for example the derivative of a sandwich with respect to the versor only retains the terms involving the versor.
+//
+// `jacobian<I...>(lambda)` collects the derivatives with respect to every component of the listed inputs into a
+// tuple. The engine fuses the tables of tuple results into one program, so loads, products and staged functions
+// shared by the columns of the Jacobian are evaluated once.
+//
+//     // Derivatives of the transformed point with respect to the six components of the generator of the motor
+//     auto [d0, d1, d2, d3, d4, d5] = compute(jacobian<1>([](auto p, auto b) { return p % versor_exp(b); }), p, b);
+//
+// Only inputs which are entities may be differentiated against, not those produced by `defer`.
+
+namespace gal
+{
+namespace detail
+{
+    // The derivative of an expression known to vanish identically. Operations involving it are simplified away
+    // before they are formed.
+    struct zero_t
+    {};
+
+    template <typename T>
+    constexpr inline bool is_zero_v = std::is_same_v<T, zero_t>;
+
+    // Tags the derivative of an expression leaf with respect to the indeterminate ID
+    template <uint32_t ID>
+    struct derivative_tag
+    {};
+
+    // A vanishing result of the algebra A standing in for a derivative which is zero in every component
+    template <typename A, typename T>
+    struct zero_tag
+    {};
+
+    template <typename E, uint32_t ID>
+    [[nodiscard]] constexpr auto leaf_derivative() noexcept
+    {
+        constexpr auto out = differentiate(E::lhs, ID);
+        return out.template resize<out.size.ind, out.size.mon, out.size.term>();
+    }
+} // namespace detail
+
+template <typename E, uint32_t ID>
+struct expr<expr_op::identity, E, detail::derivative_tag<ID>>
+{
+    using value_t               = typename E::value_t;
+    using algebra_t             = typename E::algebra_t;
+    constexpr static expr_op op = expr_op::identity;
+    constexpr static auto lhs   = detail::leaf_derivative<E, ID>();
+};
+
+template <typename A, typename T>
+struct expr<expr_op::identity, mv<A, 0, 0, 0>, detail::zero_tag<A, T>>
+{
+    using value_t               = T;
+    using algebra_t             = A;
+    constexpr static expr_op op = expr_op::identity;
+    constexpr static auto lhs   = mv<A, 0, 0, 0>{};
+};
+
+namespace detail
+{
+    // Operations on derivatives which may be zero. The zero derivative is absorbed by sums and annihilates products
+    // and linear maps.
+
+    template <typename T1, typename T2>
+    [[nodiscard]] constexpr auto d_sum(T1, T2) noexcept
+    {
+        if constexpr (is_zero_v<T1>)
+        {
+            return T2{};
+        }
+        else if constexpr (is_zero_v<T2>)
+        {
+            return T1{};
+        }
+        else
+        {
+            return expr<expr_op::sum, T1, T2>{};
+        }
+    }
+
+    template <typename T1, typename T2>
+    [[nodiscard]] constexpr auto d_difference(T1, T2) noexcept
+    {
+        if constexpr (is_zero_v<T2>)
+        {
+            return T1{};
+        }
+        else if constexpr (is_zero_v<T1>)
+        {
+            return expr<expr_op::negate, T2>{};
+        }
+        else
+        {
+            return expr<expr_op::difference, T1, T2>{};
+        }
+    }
+
+    // The linear map O (with its parameter T2, if any) applied to a derivative
+    template <expr_op O, typename T2, typename T1>
+    [[nodiscard]] constexpr auto d_linear(T1) noexcept
+    {
+        if constexpr (is_zero_v<T1>)
+        {
+            return zero_t{};
+        }
+        else
+        {
+            return expr<O, T1, T2>{};
+        }
+    }
+
+    // The bilinear product O of two factors, either of which may be a zero derivative
+    template <expr_op O, typename T1, typename T2>
+    [[nodiscard]] constexpr auto d_product(T1, T2) noexcept
+    {
+        if constexpr (is_zero_v<T1> || is_zero_v<T2>)
+        {
+            return zero_t{};
+        }
+        else
+        {
+            return expr<O, T1, T2>{};
+        }
+    }
+
+    // The scalar component of a derivative, through which the staged functions depend on their operands
+    template <typename T>
+    [[nodiscard]] constexpr auto d_scalar(T) noexcept
+    {
+        return d_linear<expr_op::select, std::integral_constant<uint8_t, 0>>(T{});
+    }
+
+    // The parameter of an operation (e.g. the grade of a selection), which not all expressions expose as `rhs_t`
+    template <typename E>
+    struct expr_parameter;
+
+    template <expr_op O, typename T1, typename T2>
+    struct expr_parameter<expr<O, T1, T2>>
+    {
+        using type = T2;
+    };
+
+    // The derivative of the expression E with respect to the indeterminate ID, or `zero_t` if it vanishes
+    template <uint32_t ID, typename E>
+    [[nodiscard]] constexpr auto derivative(E) noexcept
+    {
+        constexpr expr_op op = E::op;
+
+        if constexpr (op == expr_op::identity)
+        {
+            if constexpr (leaf_derivative<E, ID>().size.term == 0)
+            {
+                return zero_t{};
+            }
+            else
+            {
+                return expr<expr_op::identity, E, derivative_tag<ID>>{};
+            }
+        }
+        else if constexpr (op == expr_op::shift)
+        {
+            // Constant offsets vanish
+            return derivative<ID>(typename E::lhs_t{});
+        }
+        else if constexpr (op == expr_op::negate || op == expr_op::reverse || op == expr_op::poincare_dual
+                           || op == expr_op::clifford_conjugate)
+        {
+            return d_linear<op, void>(derivative<ID>(typename E::lhs_t{}));
+        }
+        else if constexpr (op == expr_op::scale || op == expr_op::extract || op == expr_op::select)
+        {
+            return d_linear<op, typename expr_parameter<E>::type>(derivative<ID>(typename E::lhs_t{}));
+        }
+        else if constexpr (op == expr_op::sum)
+        {
+            return d_sum(derivative<ID>(typename E::lhs_t{}), derivative<ID>(typename E::rhs_t{}));
+        }
+        else if constexpr (op == expr_op::difference)
+        {
+            return d_difference(derivative<ID>(typename E::lhs_t{}), derivative<ID>(typename E::rhs_t{}));
+        }
+        else if constexpr (op == expr_op::sandwich)
+        {
+            // For X % M = M X ~M, the derivative is dX % M + dM X ~M + M X ~dM
+            using x_t = typename E::lhs_t;
+            using m_t = typename E::rhs_t;
+            auto dx   = derivative<ID>(x_t{});
+            auto dm   = derivative<ID>(m_t{});
+            auto lhs  = d_product<expr_op::sandwich>(dx, m_t{});
+            auto rhs  = d_sum(d_product<expr_op::geometric>(d_product<expr_op::geometric>(dm, x_t{}), ~m_t{}),
+                             d_product<expr_op::geometric>(expr<expr_op::geometric, m_t, x_t>{},
+                                                           d_linear<expr_op::reverse, void>(dm)));
+            return d_sum(lhs, rhs);
+        }
+        else if constexpr (op < expr_op::extract)
+        {
+            // The remaining products are bilinear
+            using lhs_t = typename E::lhs_t;
+            using rhs_t = typename E::rhs_t;
+            return d_sum(d_product<op>(derivative<ID>(lhs_t{}), rhs_t{}),
+                         d_product<op>(lhs_t{}, derivative<ID>(rhs_t{})));
+        }
+        else if constexpr (op == expr_op::literal)
+        {
+            return zero_t{};
+        }
+        else if constexpr (op == expr_op::atan2)
+        {
+            // d atan2(y, x) = (x dy - y dx) / (x^2 + y^2) in the scalar components
+            auto y  = select<0>(typename E::lhs_t{});
+            auto x  = select<0>(typename E::rhs_t{});
+            auto dy = d_scalar(derivative<ID>(typename E::lhs_t{}));
+            auto dx = d_scalar(derivative<ID>(typename E::rhs_t{}));
+            return d_product<expr_op::geometric>(
+                d_difference(d_product<expr_op::geometric>(x, dy), d_product<expr_op::geometric>(y, dx)),
+                inv(x * x + y * y));
+        }
+        else
+        {
+            // The chain rule for the unary staged functions of the scalar component u of the operand
+            using u_t = typename E::lhs_t;
+            auto du   = d_scalar(derivative<ID>(u_t{}));
+            if constexpr (op == expr_op::sqrt)
+            {
+                return d_product<expr_op::geometric>(frac<1, 2> * inv(E{}), du);
+            }
+            else if constexpr (op == expr_op::inverse)
+            {
+                return d_linear<expr_op::negate, void>(d_product<expr_op::geometric>(E{} * E{}, du));
+            }
+            else if constexpr (op == expr_op::sin)
+            {
+                return d_product<expr_op::geometric>(cos(u_t{}), du);
+            }
+            else if constexpr (op == expr_op::cos)
+            {
+                return d_linear<expr_op::negate, void>(d_product<expr_op::geometric>(sin(u_t{}), du));
+            }
+            else if constexpr (op == expr_op::exp)
+            {
+                return d_product<expr_op::geometric>(E{}, du);
+            }
+        }
+    }
+
+    // A derivative of the result R returned to the engine, with vanishing derivatives represented by zero multivectors
+    template <typename R, typename D>
+    [[nodiscard]] constexpr auto d_result(D) noexcept
+    {
+        if constexpr (is_zero_v<D>)
+        {
+            using algebra_t = typename R::algebra_t;
+            return expr<expr_op::identity, mv<algebra_t, 0, 0, 0>, zero_tag<algebra_t, typename R::value_t>>{};
+        }
+        else
+        {
+            return D{};
+        }
+    }
+
+    template <uint32_t ID, typename R>
+    [[nodiscard]] constexpr auto result_derivative(R) noexcept
+    {
+        if constexpr (is_tuple_v<R>)
+        {
+            return std::apply([](auto... r) { return std::make_tuple(result_derivative<ID>(r)...); }, R{});
+        }
+        else
+        {
+            return d_result<R>(derivative<ID>(R{}));
+        }
+    }
+
+    // The input expression the engine passes for an entity numbers its indeterminates from ID
+    template <typename T>
+    struct input_leaf
+    {
+        constexpr static bool value = false;
+    };
+
+    template <typename D, uint32_t ID>
+    struct input_leaf<expr<expr_op::identity, D, std::integral_constant<uint32_t, ID>>>
+    {
+        constexpr static bool value         = true;
+        constexpr static uint32_t id        = ID;
+        constexpr static uint32_t ind_count = D::ind_count();
+    };
+
+    template <size_t I, typename... Ies>
+    using input_leaf_t = input_leaf<std::tuple_element_t<I, std::tuple<Ies...>>>;
+
+    template <size_t I, size_t... C, typename L, typename... Ies>
+    [[nodiscard]] constexpr auto input_jacobian(std::index_sequence<C...>, L const& lambda, Ies... ies) noexcept
+    {
+        using leaf_t = input_leaf_t<I, Ies...>;
+        return std::make_tuple(result_derivative<leaf_t::id + C>(lambda(ies...))...);
+    }
+} // namespace detail
+
+// The partial derivative of the result of the lambda with respect to component C of its I-th input. The returned
+// lambda is passed to `compute` (or any other entry point of the engine) in place of the original with the same
+// inputs. Lambdas returning tuples are differentiated elementwise.
+template <size_t I, size_t C = 0, typename L>
+[[nodiscard]] constexpr auto diff(L lambda) noexcept
+{
+    return [lambda](auto... ies) {
+        using leaf_t = detail::input_leaf_t<I, decltype(ies)...>;
+        static_assert(leaf_t::value, "Only entities passed directly as inputs may be differentiated against.");
+        static_assert(C < leaf_t::ind_count, "The component differentiated against is out of range.");
+        return detail::result_derivative<leaf_t::id + C>(lambda(ies...));
+    };
+}
+
+// The partial derivatives of the result of the lambda with respect to every component of the I-th inputs, in order, as
+// a tuple. Lambdas returning tuples are not supported.
+template <size_t... I, typename L>
+[[nodiscard]] constexpr auto jacobian(L lambda) noexcept
+{
+    return [lambda](auto... ies) {
+        static_assert((detail::input_leaf_t<I, decltype(ies)...>::value && ...),
+                      "Only entities passed directly as inputs may be differentiated against.");
+        static_assert(!detail::is_tuple_v<decltype(lambda(ies...))>,
+                      "The Jacobian of a lambda returning a tuple is not supported.");
+        return std::tuple_cat(detail::input_jacobian<I>(
+            std::make_index_sequence<detail::input_leaf_t<I, decltype(ies)...>::ind_count>(), lambda, ies...)...);
+    };
+}
+} // namespace gal
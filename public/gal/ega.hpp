@@ -57,7 +57,7 @@ namespace ega
         [[nodiscard]] constexpr static auto ie(uint32_t id) noexcept
         {
             return detail::construct_ie<algebra_t>(
-                id, std::make_integer_sequence<width_t, 3>{}, std::integer_sequence<uint8_t, 0b1, 0b10, 0b100>{});
+                id, std::make_integer_sequence<width_t, 3>{}, std::integer_sequence<ega_algebra::blade_t, 0b1, 0b10, 0b100>{});
         }
 
         [[nodiscard]] constexpr static size_t size() noexcept
@@ -76,7 +76,7 @@ namespace ega
             , z{c}
         {}
 
-        template <uint8_t... E>
+        template <typename ega_algebra::blade_t... E>
         constexpr vector(entity<ega_algebra, T, E...> in) noexcept
             : data{in.template select<0b1, 0b10, 0b100>()}
         {
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "approx.hpp"
 #include "entity.hpp"
+#include "program.hpp"
+#include "stage.hpp"
 
 #ifdef GAL_DEBUG
 #include "expression_debug.hpp"
+
+#include <cassert>
 #endif
 
 #include <cmath>
@@ -11,18 +16,92 @@
 
 namespace gal
 {
+// A view of entities laid out with a fixed distance in bytes between consecutive elements, e.g. the position member of
+// an array of structs. Accepted wherever batched evaluation accepts a pointer to an array.
+template <typename T>
+struct strided
+{
+    T* data;
+    size_t stride = sizeof(T);
+
+    [[nodiscard]] T& operator[](size_t index) const noexcept
+    {
+        using byte_t = std::conditional_t<std::is_const_v<T>, unsigned char const, unsigned char>;
+        return *reinterpret_cast<T*>(reinterpret_cast<byte_t*>(data) + index * stride);
+    }
+
+    [[nodiscard]] strided operator+(size_t offset) const noexcept
+    {
+        return {&(*this)[offset], stride};
+    }
+};
+
+// A view of entities stored as structure-of-arrays, with each component of the entity held in an array of its own.
+// Accepted wherever batched evaluation accepts a pointer to an array. Only entities without hidden indeterminates (i.e.
+// with `ind_count() == size()`) can be viewed this way.
+template <typename T>
+struct soa
+{
+    using value_t = std::conditional_t<std::is_const_v<T>, typename T::value_t const, typename T::value_t>;
+
+    std::array<value_t*, T::size()> data;
+
+    [[nodiscard]] soa operator+(size_t offset) const noexcept
+    {
+        soa out = *this;
+        for (auto& component : out.data)
+        {
+            component += offset;
+        }
+        return out;
+    }
+};
+
+template <typename L, typename... Data>
+struct deferred;
+
 namespace detail
 {
+    template <typename T>
+    struct is_deferred
+    {
+        constexpr static bool value = false;
+    };
+
+    template <typename L, typename... Data>
+    struct is_deferred<deferred<L, Data...>>
+    {
+        constexpr static bool value = true;
+    };
+
+    template <typename T>
+    inline constexpr bool is_deferred_v = is_deferred<T>::value;
+
+    // The indeterminate expression standing in for an input. Deferred computations are substituted by their expression
+    // over their own inputs, whose indeterminates are numbered starting at ID.
+    template <typename D, uint ID>
+    [[nodiscard]] constexpr auto input_ie(std::integral_constant<uint, ID> id) noexcept
+    {
+        if constexpr (is_deferred_v<D>)
+        {
+            return typename D::template expression_t<ID>{};
+        }
+        else
+        {
+            return expr<expr_op::identity, D, decltype(id)>{};
+        }
+    }
+
     template <typename D, typename... Ds, typename... Out, uint ID>
     [[nodiscard]] constexpr static auto ies(std::tuple<Out...> out, std::integral_constant<uint, ID> id) noexcept
     {
         if constexpr (sizeof...(Ds) == 0)
         {
-            return std::tuple_cat(out, std::make_tuple(expr<expr_op::identity, D, decltype(id)>{}));
+            return std::tuple_cat(out, std::make_tuple(input_ie<D>(id)));
         }
         else
         {
-            return ies<Ds...>(std::tuple_cat(out, std::make_tuple(expr<expr_op::identity, D, decltype(id)>{})),
+            return ies<Ds...>(std::tuple_cat(out, std::make_tuple(input_ie<D>(id))),
                               std::integral_constant<uint, ID + D::ind_count()>{});
         }
     }
@@ -48,39 +127,46 @@ namespace detail
     template <typename T>
     inline constexpr bool is_tuple_v = is_tuple<T>::value;
 
-    // The indeterminate value is either a pointer to an entity's value or an evaluated expression
-    template <typename T>
-    struct ind_value
+    // The values of all indeterminates read by a kernel, indexed by indeterminate id. Whether a value is stored by an
+    // entity or derived from the stored values is known at compile time, so inputs are resolved once up front and
+    // reads in the kernel are plain loads which the optimizer may keep in registers.
+    template <typename F, size_t N>
+    struct ind_values
     {
-        union
-        {
-            T const* pointer;
-            T value;
-        };
-
-        bool is_value;
+        std::array<F, N == 0 ? 1 : N> values;
+    };
 
-        [[nodiscard]] constexpr T operator*() const noexcept
+    template <size_t I, typename D>
+    [[nodiscard]] constexpr static auto component(D const& datum) noexcept
+    {
+        if constexpr (I < D::size())
         {
-            return is_value ? value : *pointer;
+            return datum[I];
         }
-    };
+        else
+        {
+            return datum.get(I);
+        }
+    }
 
-    template <typename T, typename D, typename... Ds>
-    constexpr static void fill(T* out, D const& datum, Ds const&... data) noexcept
+    template <typename F, typename D, size_t... I>
+    constexpr static void
+    fill_entity([[maybe_unused]] F* out, [[maybe_unused]] D const& datum, std::index_sequence<I...>) noexcept
     {
-        for (size_t i = 0; i != D::size(); ++i)
+        ((out[I] = component<I>(datum)), ...);
+    }
+
+    template <typename F, typename D, typename... Ds>
+    constexpr static void fill(F* out, D const& datum, Ds const&... data) noexcept
+    {
+        if constexpr (is_deferred_v<D>)
         {
-            auto& iv    = *(out + i);
-            iv.pointer  = &datum[i];
-            iv.is_value = false;
+            // The indeterminates of a deferred computation are those of its inputs
+            std::apply([out](auto const&... inputs) { fill(out, inputs...); }, datum.inputs);
         }
-
-        for (size_t i = D::size(); i != D::ind_count(); ++i)
+        else
         {
-            auto& iv    = *(out + i);
-            iv.value    = datum.get(i);
-            iv.is_value = true;
+            fill_entity(out, datum, std::make_index_sequence<D::ind_count()>());
         }
 
         if constexpr (sizeof...(Ds) > 0)
@@ -89,6 +175,68 @@ namespace detail
         }
     }
 
+    // Indeterminate reads performed by the compiled kernel are routed through `load` so that the same polynomial table
+    // can be evaluated against different input layouts (the values above, or a single lane of a batch block)
+    template <typename F, size_t N>
+    [[nodiscard]] constexpr F load(ind_values<F, N> const& data, width_t id) noexcept
+    {
+        return data.values[id];
+    }
+
+    // Number of lanes evaluated together by `compute_batch`. Chosen to fill the widest vector registers for single
+    // precision floats several times over while keeping the transposed block of a typical kernel resident in L1.
+    constexpr inline size_t batch_width = 16;
+
+    // A batch block stores one row per indeterminate and one column per lane (structure-of-arrays)
+    template <typename F, size_t N>
+    using batch_block = std::array<std::array<F, batch_width>, N>;
+
+    template <typename F, size_t N>
+    struct batch_lane
+    {
+        batch_block<F, N> const& block;
+        size_t index;
+    };
+
+    template <typename F, size_t N>
+    [[nodiscard]] constexpr F load(batch_lane<F, N> const& data, width_t id) noexcept
+    {
+        return data.block[id][data.index];
+    }
+
+    template <auto const& ie>
+    constexpr inline auto power_table_v = make_power_table(ie);
+
+    // Evaluate every distinct power of an indeterminate occurring in the table
+    template <auto const& ie, typename F, typename D, size_t... K>
+    [[nodiscard]] constexpr static std::array<F, sizeof...(K) == 0 ? 1 : sizeof...(K)>
+    evaluate_powers(D const& data, std::index_sequence<K...>) noexcept
+    {
+        constexpr auto const& table = power_table_v<ie>;
+        return {::gal::pow(load(data, table.powers[K].id), table.powers[K].degree.num, table.powers[K].degree.den)...};
+    }
+
+    template <auto const& ie, typename F, typename D>
+    [[nodiscard]] constexpr static auto evaluate_powers(D const& data) noexcept
+    {
+        return evaluate_powers<ie, F>(data, std::make_index_sequence<power_table_v<ie>.size>());
+    }
+
+    // The value of the indeterminate at position Index of the table, raised to its degree
+    template <typename F, auto const& ie, width_t Index, typename D>
+    [[nodiscard]] constexpr static F factor(D const& data, F const* powers) noexcept
+    {
+        constexpr width_t slot = power_table_v<ie>.slots[Index];
+        if constexpr (slot == unit_slot)
+        {
+            return load(data, ie.inds[Index].id);
+        }
+        else
+        {
+            return powers[slot];
+        }
+    }
+
     template <typename, auto const&, width_t, typename>
     struct cmon
     {};
@@ -96,8 +244,8 @@ namespace detail
     template <typename F, auto const& ie, width_t Index, size_t... I>
     struct cmon<F, ie, Index, std::index_sequence<I...>>
     {
-        template <size_t N>
-        constexpr static F value(std::array<ind_value<F>, N> const& data) noexcept
+        template <typename D>
+        constexpr static F value(D const& data, F const* powers) noexcept
         {
             constexpr auto m = ie.mons[Index];
             if constexpr (m.q.is_zero())
@@ -110,11 +258,35 @@ namespace detail
             }
             else
             {
-                return static_cast<F>(m.q)
-                       * (::gal::pow(*data[ie.inds[m.ind_offset + I].id],
-                                     ie.inds[m.ind_offset + I].degree.num,
-                                     ie.inds[m.ind_offset + I].degree.den)
-                          * ...);
+                return static_cast<F>(m.q) * (factor<F, ie, m.ind_offset + I>(data, powers) * ...);
+            }
+        }
+
+        // The sum of acc and the monomial, fusing its final multiply with the addition where possible
+        template <typename D>
+        constexpr static F accumulate(D const& data, F const* powers, F acc) noexcept
+        {
+            constexpr auto m         = ie.mons[Index];
+            constexpr size_t last = sizeof...(I) - 1;
+            if constexpr (m.q.is_zero())
+            {
+                return acc;
+            }
+            else if constexpr (sizeof...(I) == 0)
+            {
+                return acc + static_cast<F>(m.q);
+            }
+            else if constexpr (!is_fusable(m))
+            {
+                auto x = factor<F, ie, m.ind_offset>(data, powers);
+                return m.q.num > 0 ? acc + x : acc - x;
+            }
+            else
+            {
+                using std::fma;
+                auto head = static_cast<F>(m.q)
+                            * ((I == last ? F{1} : factor<F, ie, m.ind_offset + I>(data, powers)) * ...);
+                return fma(head, factor<F, ie, m.ind_offset + last>(data, powers), acc);
             }
         }
     };
@@ -126,8 +298,24 @@ namespace detail
     template <typename F, auto const& ie, size_t Offset, size_t... I>
     struct cterm<F, ie, Offset, std::index_sequence<I...>>
     {
-        template <size_t N>
-        constexpr static F value(std::array<ind_value<F>, N> const& data) noexcept
+        template <typename D>
+        constexpr static F value(D const& data, F const* powers) noexcept
+        {
+            if constexpr (sizeof...(I) == 0)
+            {
+                return {0};
+            }
+            else
+            {
+                return (
+                    cmon<F, ie, Offset + I, std::make_index_sequence<ie.mons[Offset + I].count>>::value(data, powers)
+                    + ...);
+            }
+        }
+
+        // Evaluate the term as a chain of fused multiply-adds (see `fp::fma`)
+        template <typename D>
+        constexpr static F fused(D const& data, F const* powers) noexcept
         {
             if constexpr (sizeof...(I) == 0)
             {
@@ -135,93 +323,1108 @@ namespace detail
             }
             else
             {
-                return (cmon<F, ie, Offset + I, std::make_index_sequence<ie.mons[Offset + I].count>>::value(data)
-                        + ...);
+                return fused(data, powers, std::make_index_sequence<sizeof...(I) - 1>());
+            }
+        }
+
+        template <typename D, size_t... K>
+        constexpr static F fused(D const& data, F const* powers, std::index_sequence<K...>) noexcept
+        {
+            constexpr auto order = fma_order<sizeof...(I)>(ie, Offset);
+            F out = cmon<F, ie, order[0], std::make_index_sequence<ie.mons[order[0]].count>>::value(data, powers);
+            ((out = cmon<F, ie, order[K + 1], std::make_index_sequence<ie.mons[order[K + 1]].count>>::accumulate(
+                  data, powers, out)),
+             ...);
+            return out;
+        }
+
+        template <bool Fused, typename D>
+        constexpr static F evaluate(D const& data, F const* powers) noexcept
+        {
+            if constexpr (Fused)
+            {
+                return fused(data, powers);
+            }
+            else
+            {
+                return value(data, powers);
             }
         }
     };
 
-    template <auto const& ie, typename F, typename A, size_t N, size_t... I>
-    [[nodiscard]] constexpr static auto
-    compute_entity(std::array<ind_value<F>, N> const& data, std::index_sequence<I...>) noexcept
+    template <auto const& ie, typename F, typename A, bool Fused, typename D, size_t... I>
+    [[nodiscard]] constexpr static auto compute_entity(D const& data, std::index_sequence<I...>) noexcept
     {
-        using entity_t = entity<A, F, ie.terms[I].element...>;
-        return entity_t{cterm<F, ie, ie.terms[I].mon_offset, std::make_index_sequence<ie.terms[I].count>>::value(data)...};
+        using entity_t                = entity<A, F, ie.terms[I].element...>;
+        [[maybe_unused]] auto powers = evaluate_powers<ie, F>(data);
+        return entity_t{
+            cterm<F, ie, ie.terms[I].mon_offset, std::make_index_sequence<ie.terms[I].count>>::template evaluate<Fused>(
+                data, powers.data())...};
     }
 
-    template <typename A, typename V, typename T, typename D>
-    [[nodiscard]] static auto finalize_entity(D const& data)
+    // The final table which is evaluated for an expression of type T, expressed in the basis the algebra A uses for its
+    // entities
+    template <typename A, typename T>
+    [[nodiscard]] constexpr auto finalize_table() noexcept
     {
-        constexpr static auto reified = reify<T>();
         if constexpr (detail::uses_null_basis<A>)
         {
-            constexpr static auto null_conversion = detail::to_null_basis(reified);
-            return compute_entity<null_conversion, V, A>(data, std::make_index_sequence<null_conversion.size.term>());
+            return detail::to_null_basis(reify<T>());
         }
         else
         {
-            return compute_entity<reified, V, A>(data, std::make_index_sequence<reified.size.term>());
+            return reify<T>();
         }
     }
-} // namespace detail
 
-template <typename... Data>
-struct evaluate
-{
-    template <typename L>
-    [[nodiscard]] constexpr auto operator()(L&& lambda) noexcept
+    template <typename A, typename T>
+    constexpr inline auto table_v = finalize_table<A, T>();
+
+    template <auto const& ie, auto const& p, typename F, typename A, width_t Offset, size_t... I>
+    [[nodiscard]] constexpr static auto output_entity(F const* slots, std::index_sequence<I...>) noexcept
     {
-        constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
-        using ie_result_t  = decltype(std::apply(lambda, ies));
-        return reify<ie_result_t>();
+        using entity_t = entity<A, F, ie.terms[Offset + I].element...>;
+        return entity_t{slots[p.outputs[Offset + I]]...};
     }
 
-#ifdef GAL_DEBUG
-    // Non-constexpr variant of the main evaluation operator for runtime debugging
-    template <typename L>
-    [[nodiscard]] auto debug(L&& lambda) noexcept
+    // Evaluate the table for the values of the indeterminates in data, producing the entity with the elements of its
+    // terms
+    template <auto const& table, typename A, typename V, typename... Opts, typename D>
+    [[nodiscard]] static auto evaluate_table(D const& data)
     {
-        static auto ies        = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
-        static auto expression = std::apply(lambda, ies);
-        using ie_result_t      = decltype(std::apply(lambda, ies));
-        return debug_reify<ie_result_t>();
+        if constexpr (lowers_v<Opts...>)
+        {
+            constexpr auto const& p = program_v<table, Opts...>;
+            std::array<V, p.size == 0 ? 1 : p.size> slots;
+            execute<p>(slots.data(), data, std::make_index_sequence<p.size>());
+            return output_entity<table, p, V, A, 0>(slots.data(), std::make_index_sequence<table.size.term>());
+        }
+        else
+        {
+            constexpr bool fused = has_opt_v<fp::fma, Opts...>;
+            return compute_entity<table, V, A, fused>(data, std::make_index_sequence<table.size.term>());
+        }
     }
-#endif
-};
 
-template <typename L, typename... Data>
-[[nodiscard]] static auto compute(L&& lambda, Data const&... input) noexcept
-{
-    constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
-    using ie_result_t  = decltype(std::apply(lambda, ies));
-    // Produce a lookup table keyed to the indeterminate id mapping to a union containing either an entity property or
-    // an evaluated property
-    if constexpr (detail::is_tuple_v<ie_result_t>)
+    template <typename A, typename V, typename T, typename... Opts, typename D>
+    [[nodiscard]] static auto finalize_entity(D const& data)
     {
-        if constexpr (std::tuple_size_v<ie_result_t> != 0)
+        return evaluate_table<table_v<A, T>, A, V, Opts...>(data);
+    }
+
+    // Tables of all results of a lambda returning a tuple are concatenated and evaluated by a single program, so that
+    // loads, products and monomials common to several results are computed once
+    template <typename A, typename... T>
+    constexpr inline auto fused_table_v = fuse(table_v<A, T>...);
+
+    template <typename A, typename... T>
+    [[nodiscard]] constexpr auto term_offsets() noexcept
+    {
+        std::array<width_t, sizeof...(T)> out{table_v<A, T>.size.term...};
+        width_t offset = 0;
+        for (auto& o : out)
         {
-            using value_t   = typename std::tuple_element_t<0, ie_result_t>::value_t;
-            using algebra_t = typename std::tuple_element_t<0, ie_result_t>::algebra_t;
+            auto count = o;
+            o          = offset;
+            offset += count;
+        }
+        return out;
+    }
 
-            std::array<detail::ind_value<value_t>, (Data::ind_count() + ...)> data{};
-            detail::fill(data.data(), input...);
+    template <auto const& ie, auto const& p, typename F, typename A, typename... T, size_t... K>
+    [[nodiscard]] constexpr static auto output_entities(F const* slots, std::index_sequence<K...>) noexcept
+    {
+        constexpr auto offsets = term_offsets<A, T...>();
+        return std::make_tuple(
+            output_entity<ie, p, F, A, offsets[K]>(slots, std::make_index_sequence<table_v<A, T>.size.term>())...);
+    }
+
+    template <typename A, typename... T>
+    [[nodiscard]] constexpr kernel_stats_t result_shape(std::tuple<T...>) noexcept
+    {
+        kernel_stats_t out;
+        (table_shape(table_v<A, T>, out), ...);
+        return out;
+    }
+
+    template <typename... Opts, typename T, typename... Ts>
+    [[nodiscard]] constexpr op_count fused_ops(std::tuple<T, Ts...>) noexcept
+    {
+        constexpr auto const& table = fused_table_v<typename T::algebra_t, T, Ts...>;
+        return program_v<table, Opts...>.ops();
+    }
+
+    // Number of scalar components held by an entity or tuple of entities
+    template <typename T>
+    struct result_size
+    {
+        constexpr static size_t value = T::size();
+    };
+
+    template <typename... T>
+    struct result_size<std::tuple<T...>>
+    {
+        constexpr static size_t value = (T::size() + ... + 0);
+    };
 
-            return std::apply(
-                [&](auto&&... args) {
-                    return std::make_tuple(
-                        detail::finalize_entity<algebra_t, value_t, std::decay_t<decltype(args)>>(data)...);
-                },
-                ie_result_t{});
+    // Cost of the kernel `compute<Opts...>` evaluates for the result type T (possibly a tuple)
+    template <typename T, typename... Opts>
+    [[nodiscard]] constexpr op_count result_ops() noexcept
+    {
+        if constexpr (is_tuple_v<T>)
+        {
+            return fused_ops<Opts...>(T{});
+        }
+        else
+        {
+            constexpr auto const& table = table_v<typename T::algebra_t, T>;
+            if constexpr (!lowers_v<Opts...>)
+            {
+                return table_ops(table, has_opt_v<fp::fma, Opts...>);
+            }
+            else
+            {
+                return program_v<table, Opts...>.ops();
+            }
         }
     }
-    else
+
+    // The scalar component of the expression T
+    template <typename T>
+    using scalar_part_t = expr<expr_op::extract, T, std::integer_sequence<uint32_t, 0>>;
+
+    template <typename A, typename F, typename T, typename D>
+    [[nodiscard]] constexpr static F scalar_value(D const& data) noexcept
     {
-        using value_t   = typename ie_result_t::value_t;
-        using algebra_t = typename ie_result_t::algebra_t;
+        constexpr auto const& table = table_v<A, scalar_part_t<T>>;
+        if constexpr (table.size.term == 0)
+        {
+            return {0};
+        }
+        else
+        {
+            auto powers = evaluate_powers<table, F>(data);
+            return cterm<F, table, table.terms[0].mon_offset, std::make_index_sequence<table.terms[0].count>>::value(
+                data, powers.data());
+        }
+    }
+
+    // Evaluate the non-polynomial node S from indeterminates already loaded or staged. Under `fp::approx`, the
+    // approximations of approx.hpp replace the standard library for float and double values.
+    template <typename A, typename F, typename S, typename... Opts, typename D>
+    [[nodiscard]] constexpr static F stage_value(D const& data) noexcept
+    {
+        // Calls are left unqualified so that overloads for packed types (see simd.hpp) are found via ADL
+        using std::atan2;
+        using std::cos;
+        using std::exp;
+        using std::sin;
+        using std::sqrt;
+
+        if constexpr (S::op == expr_op::literal)
+        {
+            return static_cast<F>(S::rhs_t::value);
+        }
+        else
+        {
+            constexpr bool approximate = has_opt_v<fp::approx, Opts...> && std::is_floating_point_v<F>;
 
-        std::array<detail::ind_value<value_t>, (Data::ind_count() + ...)> data{};
-        detail::fill(data.data(), input...);
-        return detail::finalize_entity<algebra_t, value_t, ie_result_t>(data);
+            F x = scalar_value<A, F, typename S::lhs_t>(data);
+            if constexpr (S::op == expr_op::sqrt)
+            {
+#ifdef GAL_DEBUG
+                if constexpr (is_versor_norm_v<S> && std::is_floating_point_v<F>)
+                {
+                    assert(!(x < 0) && "versor_exp and versor_log do not support generators with a positive square.");
+                }
+#endif
+                if constexpr (approximate)
+                {
+                    return approx::sqrt(x);
+                }
+                else
+                {
+                    return sqrt(x);
+                }
+            }
+            else if constexpr (S::op == expr_op::inverse)
+            {
+                return F{1} / x;
+            }
+            else if constexpr (S::op == expr_op::sin)
+            {
+                if constexpr (approximate)
+                {
+                    return approx::sin(x);
+                }
+                else
+                {
+                    return sin(x);
+                }
+            }
+            else if constexpr (S::op == expr_op::cos)
+            {
+                if constexpr (approximate)
+                {
+                    return approx::cos(x);
+                }
+                else
+                {
+                    return cos(x);
+                }
+            }
+            else if constexpr (S::op == expr_op::exp)
+            {
+                return exp(x);
+            }
+            else
+            {
+                F y = scalar_value<A, F, typename S::rhs_t>(data);
+                if constexpr (approximate)
+                {
+                    return approx::atan2(x, y);
+                }
+                else
+                {
+                    return atan2(x, y);
+                }
+            }
+        }
     }
-}
-} // namespace gal
+
+    // Stages are evaluated in order since later stages may read the temporaries of earlier ones
+    template <typename A, typename S, typename... Opts, typename F, size_t N, size_t... K>
+    static void evaluate_stages(ind_values<F, N>& data, std::index_sequence<K...>) noexcept
+    {
+        ((data.values[S::base + K] = stage_value<A, F, std::tuple_element_t<K, typename S::stages>, Opts...>(data)),
+         ...);
+    }
+
+    // Whether the arguments of the stage are constants, which are the same in every lane
+    template <typename A, typename Stage>
+    [[nodiscard]] constexpr bool constant_stage() noexcept
+    {
+        bool out = table_v<A, scalar_part_t<typename Stage::lhs_t>>.size.ind == 0;
+        if constexpr (Stage::op == expr_op::atan2)
+        {
+            out = out && table_v<A, scalar_part_t<typename Stage::rhs_t>>.size.ind == 0;
+        }
+        return out;
+    }
+
+    template <typename A, typename Stage, typename... Opts, typename F, size_t N>
+    constexpr static void stage_rows(batch_block<F, N>& in, size_t id) noexcept
+    {
+        if constexpr (constant_stage<A, Stage>())
+        {
+            F value = stage_value<A, F, Stage, Opts...>(batch_lane<F, N>{in, 0});
+            for (size_t lane = 0; lane != batch_width; ++lane)
+            {
+                in[id][lane] = value;
+            }
+        }
+        else
+        {
+            for (size_t lane = 0; lane != batch_width; ++lane)
+            {
+                in[id][lane] = stage_value<A, F, Stage, Opts...>(batch_lane<F, N>{in, lane});
+            }
+        }
+    }
+
+    template <typename A, typename S, typename... Opts, typename F, size_t N, size_t... K>
+    constexpr static void stage_block(batch_block<F, N>& in, std::index_sequence<K...>) noexcept
+    {
+        (stage_rows<A, std::tuple_element_t<K, typename S::stages>, Opts...>(in, S::base + K), ...);
+    }
+
+    // Cost of a stage. The non-polynomial function itself is tallied as a single multiply and literals are free.
+    template <typename S>
+    [[nodiscard]] constexpr op_count stage_ops() noexcept
+    {
+        if constexpr (S::op == expr_op::literal)
+        {
+            return op_count{};
+        }
+        else
+        {
+            using algebra_t = typename S::algebra_t;
+            op_count out    = table_ops(table_v<algebra_t, scalar_part_t<typename S::lhs_t>>);
+            if constexpr (S::op == expr_op::atan2)
+            {
+                op_count y = table_ops(table_v<algebra_t, scalar_part_t<typename S::rhs_t>>);
+                out.multiplies += y.multiplies;
+                out.additions += y.additions;
+                out.depth = y.depth > out.depth ? y.depth : out.depth;
+            }
+            ++out.multiplies;
+            ++out.depth;
+            return out;
+        }
+    }
+
+    // Cost of the staged expression S: its stages followed by the kernel `compute<Opts...>` evaluates. Stages are
+    // considered to be evaluated one after another when computing the depth.
+    template <typename S, typename... Opts, size_t... K>
+    [[nodiscard]] constexpr op_count staged_ops(std::index_sequence<K...>) noexcept
+    {
+        op_count out      = result_ops<typename S::type, Opts...>();
+        op_count stages[] = {op_count{}, stage_ops<std::tuple_element_t<K, typename S::stages>>()...};
+        for (auto const& stage : stages)
+        {
+            out.multiplies += stage.multiplies;
+            out.additions += stage.additions;
+            out.depth += stage.depth;
+        }
+        return out;
+    }
+
+    template <typename S, typename... Opts>
+    [[nodiscard]] constexpr op_count staged_ops() noexcept
+    {
+        return staged_ops<S, Opts...>(std::make_index_sequence<S::count>());
+    }
+
+    template <typename A, typename V, typename... Opts, typename... T, typename D>
+    [[nodiscard]] static auto finalize_entities(std::tuple<T...>, D const& data)
+    {
+        constexpr auto const& table = fused_table_v<A, T...>;
+        constexpr auto const& p     = program_v<table, Opts...>;
+        std::array<V, p.size == 0 ? 1 : p.size> slots;
+        execute<p>(slots.data(), data, std::make_index_sequence<p.size>());
+        return output_entities<table, p, V, A, T...>(slots.data(), std::index_sequence_for<T...>{});
+    }
+
+    // Batch inputs are either pointers to arrays of entities (one entity per lane) or entities passed by value which are
+    // broadcast to every lane
+    template <typename T>
+    struct batch_input
+    {
+        using type                  = T;
+        constexpr static bool array = false;
+    };
+
+    template <typename T>
+    struct batch_input<T*>
+    {
+        using type                  = std::remove_const_t<T>;
+        constexpr static bool array = true;
+    };
+
+    template <typename T>
+    struct batch_input<strided<T>>
+    {
+        using type                  = std::remove_const_t<T>;
+        constexpr static bool array = true;
+    };
+
+    template <typename T>
+    struct batch_input<soa<T>>
+    {
+        using type                  = std::remove_const_t<T>;
+        constexpr static bool array = true;
+        static_assert(type::ind_count() == type::size(), "Entities with hidden indeterminates have no SoA layout.");
+    };
+
+    template <typename T>
+    struct is_soa
+    {
+        constexpr static bool value = false;
+    };
+
+    template <typename T>
+    struct is_soa<soa<T>>
+    {
+        constexpr static bool value = true;
+    };
+
+    template <typename D>
+    using batch_input_t = typename batch_input<D>::type;
+
+    // Broadcast entities are written to their rows once for the entire batch
+    template <typename F, typename D, typename... Ds>
+    constexpr static void broadcast(std::array<F, batch_width>* rows, D const& datum, Ds const&... data) noexcept
+    {
+        using datum_t = batch_input_t<D>;
+        if constexpr (is_deferred_v<D>)
+        {
+            std::apply([rows](auto const&... inputs) { broadcast(rows, inputs...); }, datum.inputs);
+        }
+        else if constexpr (!batch_input<D>::array)
+        {
+            for (size_t i = 0; i != datum_t::ind_count(); ++i)
+            {
+                auto value = i < datum_t::size() ? datum[i] : datum.get(i);
+                for (size_t lane = 0; lane != batch_width; ++lane)
+                {
+                    rows[i][lane] = value;
+                }
+            }
+        }
+
+        if constexpr (sizeof...(Ds) > 0)
+        {
+            broadcast(rows + datum_t::ind_count(), data...);
+        }
+    }
+
+    // Transpose `count` consecutive entities starting at `first` into the rows of the block. Lanes past `count` replicate
+    // the last valid entity so the kernel always runs over the full block width with defined inputs.
+    template <typename F, typename D, typename... Ds>
+    constexpr static void
+    gather(std::array<F, batch_width>* rows, size_t first, size_t count, D const& datum, Ds const&... data) noexcept
+    {
+        using datum_t = batch_input_t<D>;
+        if constexpr (is_soa<D>::value)
+        {
+            // Components are already laid out as rows
+            for (size_t i = 0; i != datum_t::size(); ++i)
+            {
+                for (size_t lane = 0; lane != batch_width; ++lane)
+                {
+                    rows[i][lane] = datum.data[i][first + (lane < count ? lane : count - 1)];
+                }
+            }
+        }
+        else if constexpr (batch_input<D>::array)
+        {
+            for (size_t lane = 0; lane != batch_width; ++lane)
+            {
+                auto const& entity = datum[first + (lane < count ? lane : count - 1)];
+                for (size_t i = 0; i != datum_t::size(); ++i)
+                {
+                    rows[i][lane] = entity[i];
+                }
+                for (size_t i = datum_t::size(); i != datum_t::ind_count(); ++i)
+                {
+                    rows[i][lane] = entity.get(i);
+                }
+            }
+        }
+
+        if constexpr (sizeof...(Ds) > 0)
+        {
+            gather(rows + datum_t::ind_count(), first, count, data...);
+        }
+    }
+
+    // Evaluate every term of the table lane-by-lane. The inner loop carries no dependencies across lanes and reads and
+    // writes contiguous rows so that it is amenable to auto-vectorization.
+    template <auto const& ie, typename... Opts, typename F, size_t N, size_t... I>
+    constexpr static void
+    compute_block(batch_block<F, N> const& in, batch_block<F, sizeof...(I)>& out, std::index_sequence<I...>) noexcept
+    {
+        for (size_t lane = 0; lane != batch_width; ++lane)
+        {
+            batch_lane<F, N> data{in, lane};
+            if constexpr (lowers_v<Opts...>)
+            {
+                constexpr auto const& p = program_v<ie, Opts...>;
+                std::array<F, p.size == 0 ? 1 : p.size> slots;
+                execute<p>(slots.data(), data, std::make_index_sequence<p.size>());
+                ((out[I][lane] = slots[p.outputs[I]]), ...);
+            }
+            else
+            {
+                [[maybe_unused]] auto powers = evaluate_powers<ie, F>(data);
+                ((out[I][lane] = cterm<F, ie, ie.terms[I].mon_offset, std::make_index_sequence<ie.terms[I].count>>::
+                      template evaluate<has_opt_v<fp::fma, Opts...>>(data, powers.data())),
+                 ...);
+            }
+        }
+    }
+
+    template <auto const& ie, typename A, typename F, typename Out, size_t... I>
+    constexpr static void scatter(batch_block<F, sizeof...(I)> const& in,
+                                  Out out,
+                                  size_t count,
+                                  std::index_sequence<I...>) noexcept
+    {
+        using entity_t = entity<A, F, ie.terms[I].element...>;
+        if constexpr (is_soa<Out>::value)
+        {
+            using out_t = batch_input_t<Out>;
+            for (size_t lane = 0; lane != count; ++lane)
+            {
+                out_t value = entity_t{in[I][lane]...};
+                for (size_t i = 0; i != out_t::size(); ++i)
+                {
+                    out.data[i][lane] = value[i];
+                }
+            }
+        }
+        else
+        {
+            for (size_t lane = 0; lane != count; ++lane)
+            {
+                out[lane] = entity_t{in[I][lane]...};
+            }
+        }
+    }
+
+    // The first indeterminate of each input
+    template <typename... Data>
+    [[nodiscard]] constexpr std::array<size_t, sizeof...(Data)> ind_offsets() noexcept
+    {
+        std::array<size_t, sizeof...(Data)> out{Data::ind_count()...};
+        size_t offset = 0;
+        for (auto& o : out)
+        {
+            auto count = o;
+            o          = offset;
+            offset += count;
+        }
+        return out;
+    }
+
+    // Whether every indeterminate read by the table is marked in the mask
+    template <auto const& ie, size_t N>
+    [[nodiscard]] constexpr bool reads_only(std::array<bool, N> const& mask) noexcept
+    {
+        for (width_t i = 0; i != ie.size.ind; ++i)
+        {
+            if (ie.inds[i].id >= N || !mask[ie.inds[i].id])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename A, typename Stage, size_t N>
+    [[nodiscard]] constexpr bool bound_stage(std::array<bool, N> const& mask) noexcept
+    {
+        bool out = reads_only<table_v<A, scalar_part_t<typename Stage::lhs_t>>>(mask);
+        if constexpr (Stage::op == expr_op::atan2)
+        {
+            out = out && reads_only<table_v<A, scalar_part_t<typename Stage::rhs_t>>>(mask);
+        }
+        return out;
+    }
+
+    // The indeterminates of the staged expression S which are known once those in [First, Last) are bound: the bound
+    // indeterminates themselves and the staged temporaries computed from bound indeterminates alone
+    template <typename A, typename S, size_t First, size_t Last, size_t... K>
+    [[nodiscard]] constexpr auto bound_mask(std::index_sequence<K...>) noexcept
+    {
+        std::array<bool, S::base + S::count> out{};
+        for (size_t i = First; i != Last; ++i)
+        {
+            out[i] = true;
+        }
+        ((out[S::base + K] = bound_stage<A, std::tuple_element_t<K, typename S::stages>>(out)), ...);
+        return out;
+    }
+
+    template <typename A, typename S, size_t First, size_t Last>
+    constexpr inline auto bound_mask_v = bound_mask<A, S, First, Last>(std::make_index_sequence<S::count>());
+
+    template <typename A, typename S, size_t First, size_t Last>
+    constexpr inline auto bound_split_v
+        = split(table_v<A, typename S::type>, bound_mask_v<A, S, First, Last>, S::base + S::count);
+
+    template <auto const& s>
+    constexpr inline auto coefficient_table_v
+        = s.coefficients.template resize<s.coefficients.size.ind, s.coefficients.size.mon, s.coefficients.size.term>();
+
+    template <auto const& s>
+    constexpr inline auto free_table_v = s.free.template resize<s.free.size.ind, s.free.size.mon, s.free.size.term>();
+
+    // The indeterminates read by a bound kernel. Those marked in the mask (and the coefficients following them) were
+    // computed when binding and the others are written for each invocation.
+    template <auto const& mask, typename F, size_t N>
+    struct partial_values
+    {
+        ind_values<F, N> const& bound;
+        ind_values<F, N> const& free;
+    };
+
+    template <auto const& mask, typename F, size_t N>
+    [[nodiscard]] constexpr F load(partial_values<mask, F, N> const& data, width_t id) noexcept
+    {
+        return id >= mask.size() || mask[id] ? data.bound.values[id] : data.free.values[id];
+    }
+
+    // The value of every term of the table
+    template <auto const& ie, typename F, typename D, size_t... I>
+    constexpr static void evaluate_terms(D const& data, [[maybe_unused]] F* out, std::index_sequence<I...>) noexcept
+    {
+        [[maybe_unused]] auto powers = evaluate_powers<ie, F>(data);
+        ((out[I] = cterm<F, ie, ie.terms[I].mon_offset, std::make_index_sequence<ie.terms[I].count>>::value(
+              data, powers.data())),
+         ...);
+    }
+
+    // Evaluate the stages of S which are marked in the mask (if Bound) or those which are not
+    template <typename A, typename S, auto const& mask, bool Bound, typename... Opts, typename D, typename F, size_t N,
+              size_t... K>
+    static void evaluate_partial_stages(D const& data, ind_values<F, N>& out, std::index_sequence<K...>) noexcept
+    {
+        [[maybe_unused]] auto stage = [&data, &out](auto k) {
+            using stage_t       = std::tuple_element_t<decltype(k)::value, typename S::stages>;
+            constexpr size_t id = S::base + decltype(k)::value;
+            if constexpr (mask[id] == Bound)
+            {
+                out.values[id] = stage_value<A, F, stage_t, Opts...>(data);
+            }
+        };
+        (stage(std::integral_constant<size_t, K>{}), ...);
+    }
+
+    template <typename A, typename S, auto const& mask, typename... Opts, typename F, size_t N, size_t... K>
+    constexpr static void stage_partial_block(batch_block<F, N>& in, std::index_sequence<K...>) noexcept
+    {
+        [[maybe_unused]] auto stage = [&in](auto k) {
+            using stage_t       = std::tuple_element_t<decltype(k)::value, typename S::stages>;
+            constexpr size_t id = S::base + decltype(k)::value;
+            if constexpr (!mask[id])
+            {
+                stage_rows<A, stage_t, Opts...>(in, id);
+            }
+        };
+        (stage(std::integral_constant<size_t, K>{}), ...);
+    }
+
+    // Cost of evaluating the free table and the stages of S not marked in the mask
+    template <auto const& table, typename S, auto const& mask, typename... Opts, size_t... K>
+    [[nodiscard]] constexpr op_count partial_ops(std::index_sequence<K...>) noexcept
+    {
+        op_count out;
+        if constexpr (lowers_v<Opts...>)
+        {
+            out = program_v<table, Opts...>.ops();
+        }
+        else
+        {
+            out = table_ops(table, has_opt_v<fp::fma, Opts...>);
+        }
+
+        op_count stages[] = {
+            op_count{}, (mask[S::base + K] ? op_count{} : stage_ops<std::tuple_element_t<K, typename S::stages>>())...};
+        for (auto const& stage : stages)
+        {
+            out.multiplies += stage.multiplies;
+            out.additions += stage.additions;
+            out.depth += stage.depth;
+        }
+        return out;
+    }
+} // namespace detail
+
+template <typename... Data>
+struct evaluate
+{
+    template <typename L>
+    [[nodiscard]] constexpr auto operator()(L&& lambda) noexcept
+    {
+        constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+        using ie_result_t  = decltype(std::apply(lambda, ies));
+        using staged_t     = detail::staged<ie_result_t, (Data::ind_count() + ...)>;
+        return reify<typename staged_t::type>();
+    }
+
+    // Report the arithmetic performed by the kernel `compute<Opts...>` evaluates for the lambda
+    template <typename... Opts, typename L>
+    [[nodiscard]] constexpr op_count ops(L&& lambda) noexcept
+    {
+        constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+        using ie_result_t  = decltype(std::apply(lambda, ies));
+        return detail::staged_ops<detail::staged<ie_result_t, (Data::ind_count() + ...)>, Opts...>();
+    }
+
+    // Report the arithmetic performed by the kernel before and after common subexpression elimination
+    template <typename L>
+    [[nodiscard]] constexpr cse_stats cse(L&& lambda) noexcept
+    {
+        return {ops(lambda), ops<opt::cse>(lambda)};
+    }
+
+#ifdef GAL_DEBUG
+    // Non-constexpr variant of the main evaluation operator for runtime debugging
+    template <typename L>
+    [[nodiscard]] auto debug(L&& lambda) noexcept
+    {
+        static auto ies        = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+        static auto expression = std::apply(lambda, ies);
+        using ie_result_t      = decltype(std::apply(lambda, ies));
+        return debug_reify<ie_result_t>();
+    }
+#endif
+};
+
+// Evaluate the lambda for the supplied inputs. Optimization policies from the `opt` namespace may be supplied as explicit
+// template arguments (e.g. `compute<opt::cse>(lambda, inputs...)`).
+template <typename... Opts, typename L, typename... Data>
+[[nodiscard]] static auto compute(L&& lambda, Data const&... input) noexcept
+{
+    constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+    // Non-polynomial nodes are staged into scalar temporaries which follow the indeterminates of the inputs
+    using staged_t        = detail::staged<decltype(std::apply(lambda, ies)), (Data::ind_count() + ...)>;
+    using ie_result_t     = typename staged_t::type;
+    constexpr auto stages = std::make_index_sequence<staged_t::count>();
+    // Resolve the values of all indeterminates (inputs followed by staged temporaries) before evaluating the kernel
+    if constexpr (detail::is_tuple_v<ie_result_t>)
+    {
+        if constexpr (std::tuple_size_v<ie_result_t> != 0)
+        {
+            using value_t   = typename std::tuple_element_t<0, ie_result_t>::value_t;
+            using algebra_t = typename std::tuple_element_t<0, ie_result_t>::algebra_t;
+
+            detail::ind_values<value_t, staged_t::base + staged_t::count> data;
+            detail::fill(data.values.data(), input...);
+            detail::evaluate_stages<algebra_t, staged_t, Opts...>(data, stages);
+
+            return detail::finalize_entities<algebra_t, value_t, Opts...>(ie_result_t{}, data);
+        }
+    }
+    else
+    {
+        using value_t   = typename ie_result_t::value_t;
+        using algebra_t = typename ie_result_t::algebra_t;
+
+        detail::ind_values<value_t, staged_t::base + staged_t::count> data;
+        detail::fill(data.values.data(), input...);
+        detail::evaluate_stages<algebra_t, staged_t, Opts...>(data, stages);
+        return detail::finalize_entity<algebra_t, value_t, ie_result_t, Opts...>(data);
+    }
+}
+
+// Evaluate the lambda for `count` sets of inputs, writing the i-th result to `out[i]`. Each input is either a pointer to
+// an array of `count` entities, a `strided` or `soa` view of `count` entities, or a single entity which is broadcast
+// across the batch. The expression is reified once and inputs are transposed into structure-of-arrays blocks of
+// `detail::batch_width` lanes which are then evaluated in a vectorizable loop. `out` is a pointer, `strided` or `soa`
+// view whose elements must be constructible from the entity `compute` would return for the same lambda (e.g. the entity
+// itself or a model type such as `pga::point` which converts from it). Optimization policies are accepted as with
+// `compute`.
+// Lambdas returning multiple results (as a tuple) are not supported in batch form.
+template <typename... Opts, typename L, typename Out, typename... Data>
+static void compute_batch(L&& lambda, size_t count, Out out, Data const&... input) noexcept
+{
+    constexpr auto ies = detail::ies<detail::batch_input_t<Data>...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+    constexpr uint32_t ind_count = (detail::batch_input_t<Data>::ind_count() + ...);
+    using staged_t               = detail::staged<decltype(std::apply(lambda, ies)), ind_count>;
+    using ie_result_t            = typename staged_t::type;
+    static_assert(!detail::is_tuple_v<ie_result_t>, "compute_batch does not support lambdas returning tuples.");
+
+    using value_t               = typename ie_result_t::value_t;
+    using algebra_t             = typename ie_result_t::algebra_t;
+    constexpr auto const& table = detail::table_v<algebra_t, ie_result_t>;
+    constexpr auto terms        = std::make_index_sequence<table.size.term>();
+    constexpr auto stages       = std::make_index_sequence<staged_t::count>();
+
+    detail::batch_block<value_t, staged_t::base + staged_t::count> in;
+    detail::batch_block<value_t, table.size.term> result;
+    detail::broadcast(in.data(), input...);
+
+    for (size_t first = 0; first < count; first += detail::batch_width)
+    {
+        size_t lanes = count - first < detail::batch_width ? count - first : detail::batch_width;
+        detail::gather(in.data(), first, lanes, input...);
+        detail::stage_block<algebra_t, staged_t, Opts...>(in, stages);
+        detail::compute_block<table, Opts...>(in, result, terms);
+        detail::scatter<table, algebra_t>(result, out + first, lanes, terms);
+    }
+}
+
+// A lazy handle to the result of evaluating the lambda L for the stored inputs. Passing a handle to `compute` (or to
+// `defer` again) substitutes the expression of the lambda in place of an input, so that chained computations are
+// reified and evaluated as a single kernel without materializing the intermediate result. Create handles with `defer`.
+// Only lambdas returning a single result may be deferred.
+template <typename L, typename... Data>
+struct deferred
+{
+    // The expression of the deferred result with its indeterminates numbered starting at ID
+    template <uint ID>
+    using expression_t = decltype(std::apply(std::declval<L&>(),
+                                             detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, ID>{})));
+
+    static_assert(!detail::is_tuple_v<expression_t<0>>, "Lambdas returning tuples cannot be deferred.");
+
+    using value_t   = typename expression_t<0>::value_t;
+    using algebra_t = typename expression_t<0>::algebra_t;
+
+    // The reified multivector of the deferred result in terms of the indeterminates of its inputs (followed by any
+    // staged temporaries)
+    using mv_t = std::decay_t<
+        decltype(reify<typename detail::staged<expression_t<0>, (Data::ind_count() + ... + 0)>::type>())>;
+
+    [[nodiscard]] constexpr static size_t size() noexcept
+    {
+        return (Data::size() + ... + 0);
+    }
+
+    [[nodiscard]] constexpr static size_t ind_count() noexcept
+    {
+        return (Data::ind_count() + ... + 0);
+    }
+
+    L lambda;
+    std::tuple<Data...> inputs;
+
+    // Evaluate the deferred computation on its own
+    [[nodiscard]] auto value() const noexcept
+    {
+        return std::apply([this](auto const&... input) { return compute(lambda, input...); }, inputs);
+    }
+};
+
+// Defer evaluating the lambda for the supplied inputs (which are copied). See `deferred`.
+template <typename L, typename... Data>
+[[nodiscard]] constexpr auto defer(L lambda, Data const&... input) noexcept
+{
+    return deferred<L, Data...>{lambda, {input...}};
+}
+
+template <typename L, typename Opts, size_t I, typename... Data>
+struct bound_kernel;
+
+// A compiled kernel evaluating the lambda L for inputs of types Data under the optimization policies Opts. Kernels hold
+// only the lambda (and so are empty for captureless lambdas); all type derivation, reification, and lowering happens
+// once when the kernel type is instantiated so that invocations only perform the arithmetic. Create kernels with
+// `compile`.
+template <typename L, typename Opts, typename... Data>
+struct kernel;
+
+template <typename L, typename... Opts, typename... Data>
+struct kernel<L, std::tuple<Opts...>, Data...>
+{
+    using ie_result_t = decltype(std::apply(std::declval<L>(),
+                                            detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{})));
+
+    // The entity (or tuple of entities) produced by a single invocation
+    using result_t = decltype(compute<Opts...>(std::declval<L>(), std::declval<Data const&>()...));
+
+    // Number of inputs and the number of scalar components read from them
+    constexpr static size_t input_count = sizeof...(Data);
+    constexpr static size_t input_size  = (Data::size() + ...);
+
+    // Number of scalar components written per invocation
+    constexpr static size_t output_size = detail::result_size<result_t>::value;
+
+    // Arithmetic performed per invocation
+    constexpr static op_count ops
+        = detail::staged_ops<detail::staged<ie_result_t, (Data::ind_count() + ...)>, Opts...>();
+    constexpr static size_t flops = ops.multiplies + ops.additions;
+
+    L lambda;
+
+    [[nodiscard]] result_t operator()(Data const&... input) const noexcept
+    {
+        return compute<Opts...>(lambda, input...);
+    }
+
+    // Batched invocation over `count` inputs. Each input is a pointer to an array, a `strided` view, or an entity which
+    // is broadcast (see `compute_batch`).
+    template <typename Out, typename... In>
+    void operator()(size_t count, Out* out, In const&... input) const noexcept
+    {
+        static_assert(sizeof...(In) == sizeof...(Data), "Batched kernel invoked with the wrong number of inputs.");
+        compute_batch<Opts...>(lambda, count, out, input...);
+    }
+
+    // Strided invocation writing results to a `strided` view
+    template <typename Out, typename... In>
+    void operator()(size_t count, strided<Out> out, In const&... input) const noexcept
+    {
+        static_assert(sizeof...(In) == sizeof...(Data), "Strided kernel invoked with the wrong number of inputs.");
+        compute_batch<Opts...>(lambda, count, out, input...);
+    }
+
+    // Invocation writing each component of the results to an array of its own
+    template <typename Out, typename... In>
+    void operator()(size_t count, soa<Out> out, In const&... input) const noexcept
+    {
+        static_assert(sizeof...(In) == sizeof...(Data), "SoA kernel invoked with the wrong number of inputs.");
+        compute_batch<Opts...>(lambda, count, out, input...);
+    }
+
+    // Bind input I to a value which stays fixed over many invocations (e.g. the motor applied to many points),
+    // returning a kernel over the remaining inputs. See `bound_kernel`.
+    template <size_t I>
+    [[nodiscard]] auto bind(std::tuple_element_t<I, std::tuple<Data...>> const& value) const noexcept
+    {
+        return bound_kernel<L, std::tuple<Opts...>, I, Data...>{value};
+    }
+};
+
+// A kernel with its input I bound to a fixed value, taking the remaining inputs in order. Every monomial of the reified
+// expression is split at compile time into the factors of bound indeterminates and those of free ones (see
+// `detail::split`). Monomials sharing their free factors are grouped, and the sums of their bound parts are evaluated
+// into a block of coefficients once, when binding, along with any staged temporaries depending only on the bound
+// input. Invocations then evaluate a polynomial in the free inputs alone. Binding the motor of the sandwich p % m,
+// for example, leaves an affine map of the point with the coefficients of a 3x4 matrix. Create bound kernels with
+// `kernel::bind`. Lambdas returning tuples cannot be bound.
+template <typename L, typename... Opts, size_t I, typename... Data>
+struct bound_kernel<L, std::tuple<Opts...>, I, Data...>
+{
+    using staged_t = detail::staged<decltype(std::apply(
+                                        std::declval<L>(),
+                                        detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{}))),
+                                    (Data::ind_count() + ...)>;
+    using ie_result_t = typename staged_t::type;
+    static_assert(!detail::is_tuple_v<ie_result_t>, "Kernels returning tuples cannot be bound.");
+
+    using value_t   = typename ie_result_t::value_t;
+    using algebra_t = typename ie_result_t::algebra_t;
+    using bound_t   = std::tuple_element_t<I, std::tuple<Data...>>;
+
+    // The entity produced by a single invocation
+    using result_t = decltype(compute<Opts...>(std::declval<L>(), std::declval<Data const&>()...));
+
+    constexpr static auto offsets = detail::ind_offsets<Data...>();
+    constexpr static auto stages  = std::make_index_sequence<staged_t::count>();
+
+    // The indeterminates of the bound input
+    constexpr static size_t bound_begin = offsets[I];
+    constexpr static size_t bound_end   = offsets[I] + bound_t::ind_count();
+
+    constexpr static auto const& mask  = detail::bound_mask_v<algebra_t, staged_t, bound_begin, bound_end>;
+    constexpr static auto const& split = detail::bound_split_v<algebra_t, staged_t, bound_begin, bound_end>;
+    constexpr static auto const& coefficient_table = detail::coefficient_table_v<split>;
+    constexpr static auto const& free_table        = detail::free_table_v<split>;
+
+    // Number of coefficients evaluated when binding
+    constexpr static size_t coefficient_count = coefficient_table.size.term;
+
+    // Arithmetic performed per invocation
+    constexpr static op_count ops
+        = detail::partial_ops<free_table, staged_t, mask, Opts...>(std::make_index_sequence<staged_t::count>());
+
+    // Values of the indeterminates known once bound (those of the bound input and the staged temporaries computed from
+    // them) followed by the coefficients. The slots of the free indeterminates are unused.
+    constexpr static size_t value_count = staged_t::base + staged_t::count + coefficient_count;
+    detail::ind_values<value_t, value_count> data{};
+
+    explicit bound_kernel(bound_t const& value) noexcept
+    {
+        detail::fill(data.values.data() + offsets[I], value);
+        detail::evaluate_partial_stages<algebra_t, staged_t, mask, true, Opts...>(data, data, stages);
+        detail::evaluate_terms<coefficient_table, value_t>(
+            data, data.values.data() + staged_t::base + staged_t::count, std::make_index_sequence<coefficient_count>());
+    }
+
+    // Invocation for the free inputs (the batched overloads take two more arguments)
+    template <typename... In, typename = std::enable_if_t<sizeof...(In) + 1 == sizeof...(Data)>>
+    [[nodiscard]] result_t operator()(In const&... input) const noexcept
+    {
+        detail::ind_values<value_t, value_count> free;
+        detail::partial_values<mask, value_t, value_count> values{data, free};
+        visit_free([&free](size_t offset, auto const& datum) { detail::fill(free.values.data() + offset, datum); },
+                   input...);
+        detail::evaluate_partial_stages<algebra_t, staged_t, mask, false, Opts...>(values, free, stages);
+        return detail::evaluate_table<free_table, algebra_t, value_t, Opts...>(values);
+    }
+
+    // Batched invocation over `count` sets of the free inputs, accepting the same inputs and outputs as
+    // `compute_batch`. The bound values and coefficients are broadcast once for the entire batch.
+    template <typename Out, typename... In>
+    void operator()(size_t count, Out* out, In const&... input) const noexcept
+    {
+        evaluate_batch(count, out, input...);
+    }
+
+    template <typename Out, typename... In>
+    void operator()(size_t count, strided<Out> out, In const&... input) const noexcept
+    {
+        evaluate_batch(count, out, input...);
+    }
+
+    template <typename Out, typename... In>
+    void operator()(size_t count, soa<Out> out, In const&... input) const noexcept
+    {
+        evaluate_batch(count, out, input...);
+    }
+
+private:
+    // Apply f to each of the free inputs along with the index of its first indeterminate
+    template <typename F, typename... In>
+    static void visit_free(F&& f, In const&... input) noexcept
+    {
+        visit_free(f, std::index_sequence_for<In...>(), input...);
+    }
+
+    template <typename F, size_t... J, typename... In>
+    static void visit_free(F&& f, std::index_sequence<J...>, In const&... input) noexcept
+    {
+        (f(offsets[J < I ? J : J + 1], input), ...);
+    }
+
+    template <typename Out, typename... In>
+    void evaluate_batch(size_t count, Out out, In const&... input) const noexcept
+    {
+        static_assert(sizeof...(In) + 1 == sizeof...(Data), "Batched kernel invoked with the wrong number of inputs.");
+        constexpr auto terms = std::make_index_sequence<free_table.size.term>();
+
+        detail::batch_block<value_t, value_count> in;
+        detail::batch_block<value_t, free_table.size.term> result;
+        for (size_t i = 0; i != value_count; ++i)
+        {
+            if (i >= mask.size() || mask[i])
+            {
+                for (size_t lane = 0; lane != detail::batch_width; ++lane)
+                {
+                    in[i][lane] = data.values[i];
+                }
+            }
+        }
+        visit_free([&in](size_t offset, auto const& datum) { detail::broadcast(in.data() + offset, datum); }, input...);
+
+        for (size_t first = 0; first < count; first += detail::batch_width)
+        {
+            size_t lanes = count - first < detail::batch_width ? count - first : detail::batch_width;
+            auto gather = [&in, first, lanes](size_t offset, auto const& datum) {
+                detail::gather(in.data() + offset, first, lanes, datum);
+            };
+            visit_free(gather, input...);
+            detail::stage_partial_block<algebra_t, staged_t, mask, Opts...>(in, stages);
+            detail::compute_block<free_table, Opts...>(in, result, terms);
+            detail::scatter<free_table, algebra_t>(result, out + first, lanes, terms);
+        }
+    }
+};
+
+// Compile the lambda into a reusable kernel for the input types Data. Optimization policies may be passed as trailing
+// arguments, e.g. `compile<point<>, motor<>>(lambda, opt::cse{})`.
+template <typename... Data, typename L, typename... Opts>
+[[nodiscard]] constexpr auto compile(L lambda, Opts...) noexcept
+{
+    return kernel<L, std::tuple<Opts...>, Data...>{lambda};
+}
+
+// Report the shape and cost of the kernel `compute` evaluates for the lambda with inputs of types Data. Optimization
+// policies may be passed as trailing arguments as with `compile`. The number of terms and monomials and the maximum
+// degree describe the reified expression, while arithmetic counts reflect the kernel actually evaluated (for lambdas
+// returning tuples, the fused kernel computing all results).
+template <typename... Data, typename L, typename... Opts>
+[[nodiscard]] constexpr kernel_stats_t kernel_stats(L&& lambda, Opts...) noexcept
+{
+    constexpr auto ies = detail::ies<Data...>(std::tuple<>{}, std::integral_constant<uint, 0>{});
+    using staged_t     = detail::staged<decltype(std::apply(lambda, ies)), (Data::ind_count() + ...)>;
+    using ie_result_t  = typename staged_t::type;
+
+    kernel_stats_t out;
+    if constexpr (detail::is_tuple_v<ie_result_t>)
+    {
+        using algebra_t = typename std::tuple_element_t<0, ie_result_t>::algebra_t;
+        out             = detail::result_shape<algebra_t>(ie_result_t{});
+    }
+    else
+    {
+        detail::table_shape(detail::table_v<typename ie_result_t::algebra_t, ie_result_t>, out);
+    }
+
+    constexpr auto ops = detail::staged_ops<staged_t, Opts...>();
+    out.multiplies     = ops.multiplies;
+    out.additions      = ops.additions;
+    out.depth          = ops.depth;
+    return out;
+}
+} // namespace gal
+
+// Fail compilation if a kernel performs more than `budget` multiplies. `stats` is any constant expression with a
+// `multiplies` member, such as the result of `gal::kernel_stats` or the `ops` member of a kernel. Expressions containing
+// commas (e.g. template argument lists) must be parenthesized.
+//
+//     GAL_KERNEL_BUDGET((gal::kernel_stats<point<>, motor<>>([](auto p, auto m) { return p % m; })), 200);
+#define GAL_KERNEL_BUDGET(stats, budget) \
+    static_assert((stats).multiplies <= (budget), "Kernel exceeds its budget of " #budget " multiplies.")
@@ -6,9 +6,9 @@ namespace gal
 {
 namespace detail
 {
-    template <typename A, width_t... N, uint8_t... E>
+    template <typename A, width_t... N, typename B, B... E>
     [[nodiscard]] constexpr static auto
-    construct_ie(uint32_t id, std::integer_sequence<width_t, N...>, std::integer_sequence<uint8_t, E...>) noexcept
+    construct_ie(uint32_t id, std::integer_sequence<width_t, N...>, std::integer_sequence<B, E...>) noexcept
     {
         constexpr size_t count         = sizeof...(E);
 
@@ -16,6 +16,42 @@ namespace detail
             mv_size{count, count, count}, {ind{id + N, one}...}, {mon{one, one, 1, N}...}, {term{1, N, E}...}};
     }
 
+    // Substitute the rationals q for the indeterminates of ie (numbered from zero), leaving at most one constant
+    // monomial per term. Terms which vanish are dropped. Entities have integral degrees (e.g. the squared norm of a CGA
+    // point) so the substitution is exact.
+    template <typename A, width_t I, width_t M, width_t T, size_t N>
+    [[nodiscard]] constexpr mv<A, I, M, T> fold_constant(mv<A, I, M, T> const& ie, std::array<rat, N> const& q) noexcept
+    {
+        mv<A, I, M, T> out{};
+        for (width_t t = 0; t != ie.size.term; ++t)
+        {
+            auto const& in = ie.terms[t];
+            rat sum        = zero;
+            for (width_t m = in.mon_offset; m != in.mon_offset + in.count; ++m)
+            {
+                auto const& factors = ie.mons[m];
+                rat value           = factors.q;
+                for (width_t i = factors.ind_offset; i != factors.ind_offset + factors.count; ++i)
+                {
+                    for (int d = 0; d != ie.inds[i].degree.num; ++d)
+                    {
+                        value = value * q[ie.inds[i].id];
+                    }
+                }
+                sum = sum + value;
+            }
+
+            if (!sum.is_zero())
+            {
+                out.mons[out.size.mon]   = mon{sum, zero, 0, 0};
+                out.terms[out.size.term] = term{1, out.size.mon, in.element};
+                ++out.size.mon;
+                ++out.size.term;
+            }
+        }
+        return out;
+    }
+
     template <typename T>
     struct pseudoscalar_tag
     {};
@@ -28,12 +64,14 @@ namespace detail
 // All entities are expected to provide a static function to retrieve the entity's indeterminate expression given an
 // entity id. See the implementation for a scalar below for an example.
 // This generic entity is computed by a GAL engine and all entities are expected to be convertible from an entity.
-template <typename A, typename T, uint8_t... E>
+// The elements E identify the basis blades of the entity's components in the blade id type of the algebra.
+template <typename A, typename T, detail::blade_t<A>... E>
 struct entity
 {
     using algebra_t = A;
     using value_t   = T;
-    constexpr static std::array<uint8_t, sizeof...(E)> elements{E...};
+    using blade_t   = detail::blade_t<A>;
+    constexpr static std::array<blade_t, sizeof...(E)> elements{E...};
 
     std::array<T, sizeof...(E)> data_;
 
@@ -41,7 +79,7 @@ struct entity
     [[nodiscard]] constexpr static auto ie(uint32_t id) noexcept
     {
         return detail::construct_ie<A>(
-            id, std::make_integer_sequence<width_t, sizeof...(E)>{}, std::integer_sequence<uint8_t, E...>{});
+            id, std::make_integer_sequence<width_t, sizeof...(E)>{}, std::integer_sequence<blade_t, E...>{});
     }
 
     [[nodiscard]] constexpr static size_t size() noexcept
@@ -54,15 +92,15 @@ struct entity
         return sizeof...(E);
     }
 
-    template <uint8_t... S>
+    template <blade_t... S>
     [[nodiscard]] constexpr std::array<T, sizeof...(S)> select() const noexcept
     {
         return {select(S)...};
     }
 
-    [[nodiscard]] constexpr T select(uint8_t e) const noexcept
+    [[nodiscard]] constexpr T select(blade_t e) const noexcept
     {
-        for (uint8_t i = 0; i != elements.size(); ++i)
+        for (size_t i = 0; i != elements.size(); ++i)
         {
             if (elements[i] == e)
             {
@@ -72,9 +110,9 @@ struct entity
         return {};
     }
 
-    [[nodiscard]] constexpr T* select(uint8_t e) noexcept
+    [[nodiscard]] constexpr T* select(blade_t e) noexcept
     {
-        for (uint8_t i = 0; i != elements.size(); ++i)
+        for (size_t i = 0; i != elements.size(); ++i)
         {
             if (elements[i] == e)
             {
@@ -135,7 +173,7 @@ struct scalar
     // NOTE: in GAL code, `ie` refers always to "indeterminate expression"
     [[nodiscard]] constexpr static mv<A, 1, 1, 1> ie(uint32_t id) noexcept
     {
-        return {mv_size{1, 1, 1}, {ind{id, one}}, {mon{one, 1, 0, 1}}, {term{1, 0, 0}}};
+        return {mv_size{1, 1, 1}, {ind{id, one}}, {mon{one, one, 1, 0}}, {term{1, 0, 0}}};
     }
 
     [[nodiscard]] constexpr T const* data() const noexcept
@@ -166,4 +204,50 @@ struct scalar
 
     T value;
 };
+
+// An entity of type T whose components are the rationals Num/Den, known at compile time. Constants are passed to the
+// engine like any other input but contribute no indeterminates. Their values are folded into the rational
+// coefficients of the kernel instead, so vanishing monomials are pruned and fixed geometry costs nothing at runtime.
+template <typename T, int Den, int... Num>
+struct rational_constant
+{
+    static_assert(Den > 0, "The denominator of a constant must be positive.");
+    static_assert(sizeof...(Num) == T::size(), "A constant must provide one value for each component of the entity.");
+
+    using algebra_t = typename T::algebra_t;
+    using value_t   = typename T::value_t;
+
+    constexpr static std::array<rat, sizeof...(Num)> values{rat{Num, Den}...};
+
+    // NOTE: the id is unused as constants have no indeterminates
+    [[nodiscard]] constexpr static auto ie(uint32_t) noexcept
+    {
+        return detail::fold_constant(T::ie(0), values);
+    }
+
+    [[nodiscard]] constexpr static size_t size() noexcept
+    {
+        return 0;
+    }
+
+    [[nodiscard]] constexpr static uint32_t ind_count() noexcept
+    {
+        return 0;
+    }
+
+    [[nodiscard]] constexpr value_t operator[](size_t index) const noexcept
+    {
+        return static_cast<value_t>(values[index]);
+    }
+
+    [[nodiscard]] constexpr value_t get(size_t) const noexcept
+    {
+        // Unreachable
+        return {};
+    }
+};
+
+// Constants with integral components, e.g. `constant<pga::point<>, 0, 0, 1>`
+template <typename T, int... Num>
+using constant = rational_constant<T, 1, Num...>;
 } // namespace gal
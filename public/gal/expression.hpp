@@ -47,9 +47,26 @@ enum class expr_op
     // Projection operators
     extract, // Extract a single multivector term corresponding to a variadic list of basis elements
     select,  // Select all terms corresponding to a specified grade
+
+    //////////////////////////////////////////
+    // Non-polynomial (scalar) operations //
+    //////////////////////////////////////////
+
+    // These act on the scalar component of their operands and cannot be reified. The engine evaluates them ahead of
+    // the polynomial kernel and substitutes the results as scalar temporaries (see stage.hpp).
+    sqrt,
+    inverse,
+    sin,
+    cos,
+    exp,
+    atan2,
+
+    // A scalar constant of the value type, the `value` of the tag type passed as the second operand. It is staged like
+    // the functions above (for constants no rational represents) but assigned rather than computed.
+    literal,
 };
 
-template <int num, int den = 1>
+template <int64_t num, int64_t den = 1>
 struct frac_t
 {
     [[nodiscard]] constexpr static rat q() noexcept
@@ -58,7 +75,7 @@ struct frac_t
     }
 };
 
-template <int num, int den = 1>
+template <int64_t num, int64_t den = 1>
 constexpr inline frac_t<num, den> frac;
 
 // If O is a unary operation, T2 should be void
@@ -90,14 +107,14 @@ struct expr<expr_op::identity, T, std::integral_constant<uint32_t, ID>>
     constexpr static auto lhs   = T::ie(ID);
 };
 
-template <typename T, uint8_t... N>
-struct expr<expr_op::extract, T, std::integer_sequence<uint8_t, N...>>
+template <typename T, uint32_t... N>
+struct expr<expr_op::extract, T, std::integer_sequence<uint32_t, N...>>
 {
-    using value_t                                               = typename T::value_t;
-    using algebra_t                                             = typename T::algebra_t;
-    constexpr static expr_op op                                 = expr_op::extract;
-    using lhs_t                                                 = T;
-    constexpr static std::array<uint8_t, sizeof...(N)> elements = {N...};
+    using value_t                                                = typename T::value_t;
+    using algebra_t                                              = typename T::algebra_t;
+    constexpr static expr_op op                                  = expr_op::extract;
+    using lhs_t                                                  = T;
+    constexpr static std::array<uint32_t, sizeof...(N)> elements = {N...};
 };
 
 template <typename T, uint8_t G>
@@ -136,43 +153,43 @@ template <expr_op O1, typename T1, typename T2, expr_op O2, typename S1, typenam
     return expr<expr_op::sum, expr<O1, T1, T2>, expr<O2, S1, S2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator+(frac_t<F1, F2>, expr<O, T1, T2>)
 {
     return expr<expr_op::shift, expr<O, T1, T2>, frac_t<F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator+(expr<O, T1, T2>, frac_t<F1, F2>)
 {
     return expr<expr_op::shift, expr<O, T1, T2>, frac_t<F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator-(frac_t<F1, F2>, expr<O, T1, T2>)
 {
     return expr<expr_op::shift, expr<expr_op::negate, expr<O, T1, T2>>, frac_t<F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator-(expr<O, T1, T2>, frac_t<F1, F2>)
 {
     return expr<expr_op::shift, expr<O, T1, T2>, frac_t<-F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator*(expr<O, T1, T2>, frac_t<F1, F2>)
 {
     return expr<expr_op::scale, expr<O, T1, T2>, frac_t<F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator*(frac_t<F1, F2>, expr<O, T1, T2>)
 {
     return expr<expr_op::scale, expr<O, T1, T2>, frac_t<F1, F2>>{};
 }
 
-template <expr_op O, typename T1, typename T2, int F1, int F2>
+template <expr_op O, typename T1, typename T2, int64_t F1, int64_t F2>
 [[nodiscard]] constexpr auto operator/(expr<O, T1, T2>, frac_t<F1, F2>)
 {
     return expr<expr_op::scale, expr<O, T1, T2>, frac_t<F2, F1>>{};
@@ -226,20 +243,151 @@ template <expr_op O1, typename T1, typename T2, expr_op O2, typename S1, typenam
     return expr<expr_op::scalar, expr<O1, T1, T2>, expr<O2, S1, S2>>{};
 }
 
-template <uint8_t... E>
+template <uint32_t... E>
 struct extract
 {
     template <expr_op O, typename T1, typename T2>
     [[nodiscard]] constexpr auto operator()(expr<O, T1, T2>) noexcept
     {
-        return expr<expr_op::extract, expr<O, T1, T2>, std::integer_sequence<uint8_t, E...>>{};
+        return expr<expr_op::extract, expr<O, T1, T2>, std::integer_sequence<uint32_t, E...>>{};
     }
 };
 
+// The grade G part of the operand
+template <uint8_t G, expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto select(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::select, expr<O, T1, T2>, std::integral_constant<uint8_t, G>>{};
+}
+
+// Square root of the scalar component
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto sqrt(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::sqrt, expr<O, T1, T2>, void>{};
+}
+
+// Reciprocal of the scalar component
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto inv(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::inverse, expr<O, T1, T2>, void>{};
+}
+
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto sin(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::sin, expr<O, T1, T2>, void>{};
+}
+
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto cos(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::cos, expr<O, T1, T2>, void>{};
+}
+
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto exp(expr<O, T1, T2>) noexcept
+{
+    return expr<expr_op::exp, expr<O, T1, T2>, void>{};
+}
+
+// Angle of the point (x, y) from the scalar components of both operands, as with std::atan2
+template <expr_op O1, typename T1, typename T2, expr_op O2, typename S1, typename S2>
+[[nodiscard]] constexpr auto atan2(expr<O1, T1, T2>, expr<O2, S1, S2>) noexcept
+{
+    return expr<expr_op::atan2, expr<O1, T1, T2>, expr<O2, S1, S2>>{};
+}
+
+namespace detail
+{
+    template <typename A, typename T>
+    struct unit_tag
+    {};
+} // namespace detail
+
+template <typename A, typename T>
+struct expr<expr_op::identity, mv<A, 0, 1, 1>, detail::unit_tag<A, T>>
+{
+    using value_t               = T;
+    using algebra_t             = A;
+    constexpr static expr_op op = expr_op::identity;
+    constexpr static auto lhs   = e<A, 0>;
+};
+
+namespace detail
+{
+    // A scalar offset of e^-40 (about 4e-18) for regularizing the closed-form exponential and logarithm below.
+    // Rational coefficients this small are flushed to zero (see `overflow_gate`) so the offset is a literal instead.
+    struct versor_offset_tag
+    {
+        constexpr static double value = 4.248354255291589e-18;
+    };
+
+    template <typename E>
+    [[nodiscard]] constexpr auto versor_offset() noexcept
+    {
+        using algebra_t = typename E::algebra_t;
+        using unit_t    = expr<expr_op::identity, mv<algebra_t, 0, 1, 1>, unit_tag<algebra_t, typename E::value_t>>;
+        return expr<expr_op::literal, unit_t, versor_offset_tag>{};
+    }
+
+    // Marks the square root of the offset negated square of a generator in `versor_exp` and `versor_log`. The engine
+    // checks its argument under GAL_DEBUG, as generators with a positive square are not supported.
+    struct versor_norm_tag
+    {};
+
+    template <typename S>
+    constexpr inline bool is_versor_norm_v = false;
+
+    template <typename T>
+    constexpr inline bool is_versor_norm_v<expr<expr_op::sqrt, T, versor_norm_tag>> = true;
+
+    template <expr_op O, typename T1, typename T2>
+    [[nodiscard]] constexpr auto versor_norm(expr<O, T1, T2>) noexcept
+    {
+        return expr<expr_op::sqrt, expr<O, T1, T2>, versor_norm_tag>{};
+    }
+} // namespace detail
+
+// Closed-form exponential of a bivector B, producing a rotor, translator or motor within the same kernel. This covers
+// all bivectors whose square has the form B^2 = -u^2 + N where N is a grade 4 element squaring to zero (e.g. any
+// bivector of the Euclidean algebras, and the generators of rigid motions in PGA and CGA). Bivectors whose square has a
+// positive scalar part, such as the generators of dilations, boosts and transversions in CGA, are not supported: the
+// result is NaN, which builds with GAL_DEBUG report when the versor is evaluated.
 template <expr_op O, typename T1, typename T2>
-[[nodiscard]] constexpr auto select(expr<O, T1, T2>, uint32_t grade) noexcept
+[[nodiscard]] constexpr auto versor_exp(expr<O, T1, T2> b) noexcept
 {
-    return expr<expr_op::select, expr<O, T1, T2>, void>{grade};
+    // Writing the norm of B as the dual number w = u - N/(2u) gives B^2 = -w^2. As N^2 = 0, expanding
+    // e^B = cos(w) + sin(w)/w * B to first order in N yields
+    //     e^B = cos(u) + sinc(u) * B + N * (sinc(u)/2 + (sinc(u) - cos(u))/(2u^2) * B)
+    // The square of the norm is offset by a tiny constant so that the expression stays finite as u vanishes (e.g. for
+    // translations). As cos and sinc are flat at the origin, results are perturbed by less than the offset.
+    auto b2    = b * b;
+    auto u     = detail::versor_norm(detail::versor_offset<decltype(b)>() - b2);
+    auto u_inv = inv(u);
+    auto c     = cos(u);
+    auto k     = sin(u) * u_inv;
+    return c + k * b + frac<1, 2> * select<4>(b2) * (k + (k - c) * u_inv * u_inv * b);
+}
+
+// Closed-form logarithm of a normalized versor V = s + L + P with grades 0, 2 and 4, inverting `versor_exp` (and
+// likewise limited to bivector parts L whose square has a non-positive scalar part)
+template <expr_op O, typename T1, typename T2>
+[[nodiscard]] constexpr auto versor_log(expr<O, T1, T2> v) noexcept
+{
+    // With L^2 = -s2^2 + N, the bivector part is L = (s2 - N/(2s2)) * L_n for a unit L_n. Matching
+    // e^((u + n) L_n) = cos(u) - n sin(u) + (sin(u) + n cos(u)) L_n against V gives s = cos(u) and s2 = sin(u), so
+    // u = atan2(s2, s), and the grade 4 part n = -N/(2s2) * s - P * s2. Then log(V) = (u + n) / (s2 - N/(2s2)) * L.
+    // As with `versor_exp`, the square of s2 is offset so that u/s2 tends to 1 for translators.
+    auto l     = select<2>(v);
+    auto l2    = l * l;
+    auto s2    = detail::versor_norm(detail::versor_offset<decltype(v)>() - l2);
+    auto s_inv = inv(s2);
+    auto f     = atan2(s2, v) * s_inv;
+    auto p2    = frac<-1, 2> * select<4>(l2) * s_inv;
+    auto n     = p2 * select<0>(v) - select<4>(v) * s2;
+    return (f + (n - f * p2) * s_inv) * l;
 }
 
 template <typename exp_t>
@@ -248,6 +396,9 @@ template <typename exp_t>
     // Recursive function which compiles an expression into a reification table suitable for further processing needed
     // to evaluate all polynomial terms.
 
+    static_assert(exp_t::op < expr_op::sqrt,
+                  "Non-polynomial operations must be staged by the engine before the expression is reified.");
+
     // Base case
     if constexpr (exp_t::op == expr_op::identity)
     {
@@ -293,12 +444,14 @@ template <typename exp_t>
     }
     else if constexpr (exp_t::op == expr_op::select)
     {
-        // TODO: implement me
+        constexpr auto out = detail::select(reify<typename exp_t::lhs_t>(), exp_t::grade);
+        return out.template resize<out.size.ind, out.size.mon, out.size.term>();
     }
     else // Binary operation
     {
         constexpr auto lhs = reify<typename exp_t::lhs_t>();
         constexpr auto rhs = reify<typename exp_t::rhs_t>();
+        using algebra_t    = typename decltype(lhs)::algebra_t;
 
         if constexpr (exp_t::op == expr_op::sum)
         {
@@ -313,22 +466,21 @@ template <typename exp_t>
         }
         else if constexpr (exp_t::op == expr_op::geometric)
         {
-            constexpr auto out = detail::product(typename decltype(lhs)::algebra_t::geometric{}, lhs, rhs);
+            constexpr auto out = detail::product(typename algebra_t::geometric{}, lhs, rhs);
             return out.template resize<out.size.ind, out.size.mon, out.size.term>();
         }
         else if constexpr (exp_t::op == expr_op::sandwich)
         {
             // rhs * lhs * ~rhs
             constexpr auto rhs_reverse = detail::reverse(rhs);
-            constexpr auto temp  = detail::product(typename decltype(lhs)::algebra_t::geometric{}, lhs, rhs_reverse);
-            constexpr auto temp2 = detail::product(typename decltype(lhs)::algebra_t::geometric{},
-                                                   rhs,
-                                                   temp.template resize<temp.size.ind, temp.size.mon, temp.size.term>());
+            constexpr auto temp        = detail::product(typename algebra_t::geometric{}, lhs, rhs_reverse);
+            constexpr auto temp_exact  = temp.template resize<temp.size.ind, temp.size.mon, temp.size.term>();
+            constexpr auto temp2       = detail::product(typename algebra_t::geometric{}, rhs, temp_exact);
             return temp2.template resize<temp2.size.ind, temp2.size.mon, temp2.size.term>();
         }
         else if constexpr (exp_t::op == expr_op::exterior)
         {
-            constexpr auto out = detail::product(typename decltype(lhs)::algebra_t::exterior{}, lhs, rhs);
+            constexpr auto out = detail::product(typename algebra_t::exterior{}, lhs, rhs);
             return out.template resize<out.size.ind, out.size.mon, out.size.term>();
         }
         else if constexpr (exp_t::op == expr_op::regressive)
@@ -336,23 +488,23 @@ template <typename exp_t>
             // TODO: check if both lhs and rhs are dual
             constexpr auto lhs_dual = detail::poincare_dual(lhs);
             constexpr auto rhs_dual = detail::poincare_dual(rhs);
-            constexpr auto out = detail::product(typename decltype(lhs)::algebra_t::exterior{}, lhs_dual, rhs_dual);
+            constexpr auto out      = detail::product(typename algebra_t::exterior{}, lhs_dual, rhs_dual);
             return detail::poincare_dual(out.template resize<out.size.ind, out.size.mon, out.size.term>());
         }
         else if constexpr (exp_t::op == expr_op::contract)
         {
-            constexpr auto out = detail::product(typename decltype(lhs)::algebra_t::contract{}, lhs, rhs);
+            constexpr auto out = detail::product(typename algebra_t::contract{}, lhs, rhs);
             return out.template resize<out.size.ind, out.size.mon, out.size.term>();
         }
         else if constexpr (exp_t::op == expr_op::symmetric_inner)
         {
-            constexpr auto out = detail::product(typename decltype(lhs)::algebra_t::symmetric_inner{}, lhs, rhs);
+            constexpr auto out = detail::product(typename algebra_t::symmetric_inner{}, lhs, rhs);
             return out.template resize<out.size.ind, out.size.mon, out.size.term>();
         }
         else if constexpr (exp_t::op == expr_op::scalar)
         {
             // Compute the grade 0 element of the symmetric inner product
-            constexpr auto ip = detail::product(typename decltype(lhs)::algebra_t::symmetric_inner{}, lhs, rhs);
+            constexpr auto ip  = detail::product(typename algebra_t::symmetric_inner{}, lhs, rhs);
             constexpr auto out = detail::extract(ip, {0});
             return out.template resize<out.size.ind, out.size.mon, 1>();
         }
@@ -55,7 +55,7 @@ template <typename exp_t>
     }
     else if constexpr (exp_t::op == expr_op::select)
     {
-        // TODO: implement me
+        return detail::select(debug_reify<typename exp_t::lhs_t>(), exp_t::grade);
     }
     else
     {
@@ -2,6 +2,11 @@
 
 #include "numeric.hpp"
 
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
 // Templatized routines and operations parameterized by metric signature
 
 namespace gal
@@ -73,27 +78,128 @@ struct metric
     }
 };
 
-// The specialization with a metric signature as defined above fully specifies a tensor algebra
-template <typename Metric>
+namespace detail
+{
+    // The narrowest unsigned integer with a bit per generator of a D-dimensional metric, used to identify basis blades
+    template <size_t D>
+    using blade_id_t = std::conditional_t<D <= 8, uint8_t, std::conditional_t<D <= 16, uint16_t, uint32_t>>;
+
+    // Cayley tables hold 4^D entries and are generated for every algebra whose blade ids fit in a byte. Products in
+    // higher dimensional algebras (e.g. the 10D double conformal algebra, whose table would have a million entries) are
+    // computed from the generators directly, which costs a few operations per generator instead.
+    constexpr inline size_t cayley_max_dimension = 8;
+
+    // The product of two basis elements: the element it is proportional to and the sign (zero if the product vanishes)
+    struct cayley_entry
+    {
+        uint8_t element = 0;
+        int8_t sign     = 0;
+    };
+
+    // The Cayley table of the geometric product of an algebra with metric M between all pairs of its basis elements,
+    // indexed by (lhs << dimension) | rhs. The other products are restrictions of the geometric product and are read
+    // from the same table.
+    template <typename M>
+    struct cayley_tables
+    {
+        static_assert(M::dimension <= cayley_max_dimension, "Cayley tables are not generated for this dimension.");
+
+        constexpr static size_t dimension = M::dimension;
+        constexpr static size_t size      = size_t{1} << dimension;
+
+        std::array<cayley_entry, size * size> geometric;
+    };
+
+    // The sign of the geometric product of blades A and B is (-1)^s times the product of the squares of the generators
+    // in both, where s counts the pairs of generators i in A and j in B with i > j. Dropping the lowest generator j of
+    // B changes s by the number of generators of A above j, so each row of the table is filled in constant time per
+    // entry from entries earlier in the row.
+    template <typename M>
+    [[nodiscard]] constexpr cayley_tables<M> generate_cayley_tables() noexcept
+    {
+        constexpr size_t n = cayley_tables<M>::size;
+        cayley_tables<M> out{};
+
+        for (size_t lhs = 0; lhs != n; ++lhs)
+        {
+            auto* row = out.geometric.data() + lhs * n;
+            row[0]    = cayley_entry{static_cast<uint8_t>(lhs), 1};
+            for (size_t rhs = 1; rhs != n; ++rhs)
+            {
+                size_t low   = rhs & (~rhs + 1);
+                size_t index = pop_count(static_cast<uint32_t>(low - 1));
+                int sign     = row[rhs ^ low].sign;
+                if (pop_count(static_cast<uint32_t>(lhs & ~(2 * low - 1))) % 2 == 1)
+                {
+                    sign = -sign;
+                }
+                if (lhs & low)
+                {
+                    sign *= M::dot(index, index);
+                }
+                row[rhs] = sign == 0 ? cayley_entry{}
+                                     : cayley_entry{static_cast<uint8_t>(lhs ^ rhs), static_cast<int8_t>(sign)};
+            }
+        }
+        return out;
+    }
+
+    // Tables are generated once per metric, after which every product between basis elements during reification is a
+    // lookup
+    template <typename M>
+    constexpr inline cayley_tables<M> cayley_v = generate_cayley_tables<M>();
+
+    template <typename M>
+    [[nodiscard]] constexpr std::pair<uint8_t, int> cayley_lookup(size_t g1, size_t g2) noexcept
+    {
+        auto entry = cayley_v<M>.geometric[(g1 << M::dimension) | g2];
+        return {entry.element, entry.sign};
+    }
+} // namespace detail
+
+// The specialization with a metric signature as defined above fully specifies a tensor algebra. Basis blades are
+// identified by the bitset of their generators, stored as Blade (by default the narrowest integer wide enough).
+template <typename Metric, typename Blade = detail::blade_id_t<Metric::dimension>>
 struct algebra
 {
     using metric_t = Metric;
-    constexpr static mv<algebra<Metric>, 0, 1, 1> pseudoscalar{mv_size{0, 1, 1},
-                                                               {},
-                                                               {mon{one, zero, 0, 0}},
-                                                               {term{1, 0, (1 << metric_t::dimension) - 1}}};
-    constexpr static mv<algebra<Metric>, 0, 1, 1> pseudoscalar_inv{
+    using blade_t  = Blade;
+
+    static_assert(std::is_unsigned_v<blade_t> && metric_t::dimension <= 8 * sizeof(blade_t) && metric_t::dimension < 31,
+                  "The blade id type must have a bit for every generator of the metric.");
+
+    constexpr static mv<algebra, 0, 1, 1> pseudoscalar{mv_size{0, 1, 1},
+                                                       {},
+                                                       {mon{one, zero, 0, 0}},
+                                                       {term{1, 0, (1 << metric_t::dimension) - 1}}};
+    constexpr static mv<algebra, 0, 1, 1> pseudoscalar_inv{
         mv_size{0, 1, 1},
         {},
         {mon{((metric_t::dimension * (metric_t::dimension - 1) / 2 + metric_t::v) % 2 == 0 ? one : minus_one), zero, 0, 0}},
         {term{1, 0, (1 << metric_t::dimension) - 1}}};
 
-    // For each operation, the static product function returns a generator id and multiplier given two generators.
-    // At this point, non-diagonal metric tensors are not supported.
+    // For each operation, the static product function returns a generator id and multiplier given two generators,
+    // read from the Cayley table of the metric. The blade_product functions compute the same from the metric one
+    // generator at a time and define the products the table encodes; they are used directly for metrics too large to
+    // tabulate. At this point, non-diagonal metric tensors are not supported.
+
+    constexpr static bool tabulated = metric_t::dimension <= detail::cayley_max_dimension;
 
     struct geometric
     {
-        [[nodiscard]] constexpr static std::pair<uint8_t, int> product(uint8_t g1, uint8_t g2) noexcept
+        [[nodiscard]] constexpr static std::pair<blade_t, int> product(blade_t g1, blade_t g2) noexcept
+        {
+            if constexpr (tabulated)
+            {
+                return detail::cayley_lookup<metric_t>(g1, g2);
+            }
+            else
+            {
+                return blade_product(g1, g2);
+            }
+        }
+
+        [[nodiscard]] constexpr static std::pair<blade_t, int> blade_product(blade_t g1, blade_t g2) noexcept
         {
             if (g1 == 0)
             {
@@ -105,8 +211,8 @@ struct algebra
             }
             else
             {
-                uint8_t g     = g1 ^ g2;
-                uint8_t swaps = 0;
+                blade_t g      = g1 ^ g2;
+                uint32_t swaps = 0;
 
                 // The geometric product contracts incident generators based on the metric signature and produces
                 // higher-grade tensor products for non-incident generators.
@@ -144,7 +250,23 @@ struct algebra
 
     struct exterior
     {
-        [[nodiscard]] constexpr static std::pair<uint8_t, int> product(uint8_t g1, uint8_t g2) noexcept
+        [[nodiscard]] constexpr static std::pair<blade_t, int> product(blade_t g1, blade_t g2) noexcept
+        {
+            if constexpr (tabulated)
+            {
+                if ((g1 & g2) != 0)
+                {
+                    return {0, 0};
+                }
+                return detail::cayley_lookup<metric_t>(g1, g2);
+            }
+            else
+            {
+                return blade_product(g1, g2);
+            }
+        }
+
+        [[nodiscard]] constexpr static std::pair<blade_t, int> blade_product(blade_t g1, blade_t g2) noexcept
         {
             if (g1 == 0)
             {
@@ -156,15 +278,15 @@ struct algebra
             }
             else
             {
-                uint8_t intersection = g1 & g2;
+                blade_t intersection = g1 & g2;
                 if (intersection != 0)
                 {
                     return {0, 0};
                 }
                 else
                 {
-                    uint8_t g     = g1 | g2;
-                    uint8_t swaps = 0;
+                    blade_t g      = g1 | g2;
+                    uint32_t swaps = 0;
 
                     while (g1 > 0)
                     {
@@ -181,7 +303,23 @@ struct algebra
 
     struct contract
     {
-        [[nodiscard]] constexpr static std::pair<uint8_t, int> product(uint8_t g1, uint8_t g2) noexcept
+        [[nodiscard]] constexpr static std::pair<blade_t, int> product(blade_t g1, blade_t g2) noexcept
+        {
+            if constexpr (tabulated)
+            {
+                if ((g1 & ~g2) != 0)
+                {
+                    return {0, 0};
+                }
+                return detail::cayley_lookup<metric_t>(g1, g2);
+            }
+            else
+            {
+                return blade_product(g1, g2);
+            }
+        }
+
+        [[nodiscard]] constexpr static std::pair<blade_t, int> blade_product(blade_t g1, blade_t g2) noexcept
         {
             if (g1 == 0)
             {
@@ -193,7 +331,7 @@ struct algebra
             }
             else
             {
-                uint8_t swaps = 0;
+                uint32_t swaps = 0;
 
                 while (g1 > 0)
                 {
@@ -222,7 +360,30 @@ struct algebra
 
     struct symmetric_inner
     {
-        [[nodiscard]] constexpr static std::pair<uint8_t, int> product(uint8_t g1, uint8_t g2) noexcept
+        [[nodiscard]] constexpr static std::pair<blade_t, int> product(blade_t g1, blade_t g2) noexcept
+        {
+            if constexpr (tabulated)
+            {
+                if (g1 == 0 || g2 == 0)
+                {
+                    return {0, 0};
+                }
+                auto [g, multiplier] = detail::cayley_lookup<metric_t>(g1, g2);
+                int grade1           = static_cast<int>(pop_count(g1));
+                int grade2           = static_cast<int>(pop_count(g2));
+                if (static_cast<int>(pop_count(g)) != ::gal::detail::abs(grade1 - grade2))
+                {
+                    return {0, 0};
+                }
+                return {g, multiplier};
+            }
+            else
+            {
+                return blade_product(g1, g2);
+            }
+        }
+
+        [[nodiscard]] constexpr static std::pair<blade_t, int> blade_product(blade_t g1, blade_t g2) noexcept
         {
             if (g1 == 0 || g2 == 0)
             {
@@ -61,20 +61,15 @@ namespace detail
         }
 
         // The temp mv now needs to be sorted so that coincident terms can be collated
-        sort(temp.terms.begin(), temp.terms.begin() + temp.size.term);
-
-        // Transform the array of monomials to monomial views so they can be independently sorted as well
-        std::array<mon_view, 2 * M> mon_views;
-        for (width_t i = 0; i != temp.size.mon; ++i)
-        {
-            mon_views[i] = mon_view{temp.mons[i], temp.inds.begin()};
-        }
+        sort_terms<A>(temp.terms.begin(), temp.terms.begin() + temp.size.term);
 
+        std::array<width_t, 3 * M> scratch{};
         mv<A, 2 * I, 2 * M, 2 * T> rhs{};
         collate(temp.terms.begin(),
                 temp.terms.begin() + temp.size.term,
-                mon_views.begin(),
+                temp.mons.begin(),
                 temp.inds.begin(),
+                scratch.begin(),
                 rhs.terms.begin(),
                 rhs.mons.begin(),
                 rhs.inds.begin(),
@@ -124,20 +119,15 @@ namespace detail
         }
 
         // The temp mv now needs to be sorted so that coincident terms can be collated
-        sort(temp.terms.begin(), temp.terms.begin() + temp.size.term);
-
-        // Transform the array of monomials to monomial views so they can be independently sorted as well
-        std::array<mon_view, 2 * M> mon_views;
-        for (width_t i = 0; i != temp.size.mon; ++i)
-        {
-            mon_views[i] = mon_view{temp.mons[i], temp.inds.begin()};
-        }
+        sort_terms<A>(temp.terms.begin(), temp.terms.begin() + temp.size.term);
 
+        std::array<width_t, 3 * M> scratch{};
         mv<A, 2 * I, 2 * M, 2 * T> rhs{};
         collate(temp.terms.begin(),
                 temp.terms.begin() + temp.size.term,
-                mon_views.begin(),
+                temp.mons.begin(),
                 temp.inds.begin(),
+                scratch.begin(),
                 rhs.terms.begin(),
                 rhs.mons.begin(),
                 rhs.inds.begin(),
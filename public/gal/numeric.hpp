@@ -14,7 +14,15 @@ template <typename T>
 {
     if (d > 1)
     {
-        return std::pow(s, e/d);
+        // Calls are left unqualified so that overloads for packed types (see simd.hpp) are found via ADL
+        using std::pow;
+        using std::sqrt;
+        if (d == 2)
+        {
+            // Square roots are common enough (norms, normalization) to avoid the general power function
+            return ::gal::pow(sqrt(s), e, 1);
+        }
+        return pow(s, T(static_cast<double>(e) / static_cast<double>(d)));
     }
     else if (e < 0)
     {
@@ -98,12 +106,13 @@ template <typename T>
 }
 
 // The module we work with is attached to the field of rational numbers.
-// The numerator and denominator are left as ints (even though D > 0 is an invariant) so the compiler can help detect
-// overflows
+// The numerator and denominator are left as signed integers (even though D > 0 is an invariant) so the compiler can
+// help detect overflows. They are 64 bits wide so that compile-time constants with realistic magnitudes (see
+// `rational_constant`) can be folded into coefficients exactly.
 struct rat
 {
-    int num = 0;
-    int den = 1;
+    int64_t num = 0;
+    int64_t den = 1;
 
     [[nodiscard]] constexpr bool is_zero() const noexcept
     {
@@ -282,29 +291,29 @@ namespace detail
     }
 } // namespace detail
 
-[[nodiscard]] constexpr bool operator==(rat lhs, rat rhs) noexcept
+[[nodiscard]] constexpr bool operator==(rat const& lhs, rat const& rhs) noexcept
 {
     auto gcd1 = std::gcd(lhs.num, lhs.den);
     auto gcd2 = std::gcd(rhs.den, rhs.den);
     return lhs.num / gcd1 == rhs.num / gcd2 && lhs.den / gcd1 == rhs.den / gcd2;
 }
 
-[[nodiscard]] constexpr bool operator!=(rat lhs, int rhs) noexcept
+[[nodiscard]] constexpr bool operator!=(rat const& lhs, int rhs) noexcept
 {
     return lhs.den != 1 || lhs.num != rhs;
 }
 
-[[nodiscard]] constexpr bool operator!=(rat lhs, rat rhs) noexcept
+[[nodiscard]] constexpr bool operator!=(rat const& lhs, rat const& rhs) noexcept
 {
     return lhs.num != rhs.num || lhs.den != rhs.den;
 }
 
-[[nodiscard]] constexpr bool operator<(rat lhs, rat rhs) noexcept
+[[nodiscard]] constexpr bool operator<(rat const& lhs, rat const& rhs) noexcept
 {
     return (lhs.num * rhs.den) < (rhs.num * lhs.den);
 }
 
-[[nodiscard]] constexpr bool operator>(rat lhs, rat rhs) noexcept
+[[nodiscard]] constexpr bool operator>(rat const& lhs, rat const& rhs) noexcept
 {
     return (lhs.num * rhs.den) > (rhs.num * lhs.den);
 }
@@ -391,14 +400,14 @@ namespace detail
 
 [[nodiscard]] constexpr rat operator+(rat lhs, rat rhs) noexcept
 {
-    int n = lhs.num * rhs.den + rhs.num * lhs.den;
+    int64_t n = lhs.num * rhs.den + rhs.num * lhs.den;
     if (n == 0)
     {
         return zero;
     }
     else
     {
-        int d = lhs.den * rhs.den;
+        int64_t d = lhs.den * rhs.den;
         if (d > 1)
         {
             return detail::overflow_gate(rat{n, d});
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "engine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Multi-threaded batch evaluation. An `executor` owns a fixed pool of worker threads. `parallel_compute` splits a batch
+// into chunks sized to stay resident in a core's cache and evaluates each chunk with `compute_batch`. Chunks are dealt
+// out evenly up front and threads which run dry steal from the back of the other queues, so uneven progress (e.g. due
+// to preemption or frequency scaling) does not leave cores idle at the end of a batch.
+
+namespace gal
+{
+namespace detail
+{
+    // A range of chunk indices [first, last) packed into a single word so that the owner (taking chunks from the
+    // front) and thieves (taking chunks from the back) each claim a chunk with a single compare-and-swap
+    struct alignas(64) chunk_queue
+    {
+        constexpr static uint32_t empty = ~0u;
+
+        std::atomic<uint64_t> range{0};
+
+        void reset(uint32_t first, uint32_t last) noexcept
+        {
+            range.store((uint64_t{first} << 32) | last, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] uint32_t pop() noexcept
+        {
+            uint64_t current = range.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto first = static_cast<uint32_t>(current >> 32);
+                auto last  = static_cast<uint32_t>(current);
+                if (first >= last)
+                {
+                    return empty;
+                }
+                uint64_t next = (uint64_t{first + 1} << 32) | last;
+                if (range.compare_exchange_weak(current, next, std::memory_order_relaxed))
+                {
+                    return first;
+                }
+            }
+        }
+
+        [[nodiscard]] uint32_t steal() noexcept
+        {
+            uint64_t current = range.load(std::memory_order_relaxed);
+            while (true)
+            {
+                auto first = static_cast<uint32_t>(current >> 32);
+                auto last  = static_cast<uint32_t>(current);
+                if (first >= last)
+                {
+                    return empty;
+                }
+                uint64_t next = (uint64_t{first} << 32) | (last - 1);
+                if (range.compare_exchange_weak(current, next, std::memory_order_relaxed))
+                {
+                    return last - 1;
+                }
+            }
+        }
+    };
+
+    // Advance an input of a batch to the entity at `first`. Broadcast entities are shared by every chunk.
+    template <typename D>
+    [[nodiscard]] D batch_offset(D const& datum, size_t first) noexcept
+    {
+        if constexpr (batch_input<D>::array)
+        {
+            return datum + first;
+        }
+        else
+        {
+            return datum;
+        }
+    }
+
+    template <typename D>
+    [[nodiscard]] constexpr size_t batch_stride() noexcept
+    {
+        return batch_input<D>::array ? sizeof(batch_input_t<D>) : 0;
+    }
+} // namespace detail
+
+// A pool of worker threads for `parallel_compute`. The calling thread participates in every batch, so an executor with
+// a single thread evaluates batches inline without synchronization. Executors are neither copyable nor movable and a
+// single executor runs one batch at a time.
+struct executor
+{
+    // Chunks aim to keep the inputs and outputs they touch within half of a typical per-core L2 cache
+    constexpr static size_t default_chunk_bytes = 1 << 17;
+
+    explicit executor(size_t threads = std::thread::hardware_concurrency(), size_t chunk_bytes = default_chunk_bytes)
+        : queues_(threads == 0 ? 1 : threads)
+        , chunk_bytes_{chunk_bytes}
+    {
+        workers_.reserve(queues_.size() - 1);
+        for (size_t i = 1; i != queues_.size(); ++i)
+        {
+            workers_.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    executor(executor const&) = delete;
+    executor& operator=(executor const&) = delete;
+
+    ~executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    [[nodiscard]] size_t thread_count() const noexcept
+    {
+        return queues_.size();
+    }
+
+    [[nodiscard]] size_t chunk_bytes() const noexcept
+    {
+        return chunk_bytes_;
+    }
+
+    // The number of bytes of input and output each chunk should span. Takes effect from the next batch.
+    void chunk_bytes(size_t bytes) noexcept
+    {
+        chunk_bytes_ = bytes;
+    }
+
+    // Invoke `f(chunk)` for every chunk index in [0, chunks) across all threads and wait for completion
+    template <typename F>
+    void run(size_t chunks, F const& f) noexcept
+    {
+        if (queues_.size() == 1 || chunks < 2)
+        {
+            for (size_t chunk = 0; chunk != chunks; ++chunk)
+            {
+                f(chunk);
+            }
+            return;
+        }
+
+        for (size_t i = 0; i != queues_.size(); ++i)
+        {
+            queues_[i].reset(static_cast<uint32_t>(chunks * i / queues_.size()),
+                             static_cast<uint32_t>(chunks * (i + 1) / queues_.size()));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_    = [](void const* context, size_t chunk) { (*static_cast<F const*>(context))(chunk); };
+            context_ = &f;
+            active_  = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        drain(0);
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_.wait(lock, [this] { return active_ == 0; });
+    }
+
+private:
+    void work(size_t index) noexcept
+    {
+        uint64_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                wake_.wait(lock, [&] { return stop_ || generation_ != generation; });
+                if (stop_)
+                {
+                    return;
+                }
+                generation = generation_;
+            }
+
+            drain(index);
+
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (--active_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+    // Run chunks from our own queue, then steal from the others until every queue is empty
+    void drain(size_t index) noexcept
+    {
+        for (uint32_t chunk = queues_[index].pop(); chunk != detail::chunk_queue::empty; chunk = queues_[index].pop())
+        {
+            task_(context_, chunk);
+        }
+
+        for (size_t offset = 1; offset != queues_.size(); ++offset)
+        {
+            auto& victim = queues_[(index + offset) % queues_.size()];
+            for (uint32_t chunk = victim.steal(); chunk != detail::chunk_queue::empty; chunk = victim.steal())
+            {
+                task_(context_, chunk);
+            }
+        }
+    }
+
+    std::vector<detail::chunk_queue> queues_;
+    std::vector<std::thread> workers_;
+    size_t chunk_bytes_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;
+    size_t active_       = 0;
+    bool stop_           = false;
+
+    // The batch in flight. Published under the mutex before workers are woken.
+    void (*task_)(void const*, size_t) = nullptr;
+    void const* context_               = nullptr;
+};
+
+// Evaluate the lambda for `count` sets of inputs like `compute_batch`, spreading the batch over the threads of the
+// executor. Inputs and outputs are as with `compute_batch`. Each chunk spans a multiple of `detail::batch_width`
+// entities so that only the final chunk has a partial block.
+template <typename... Opts, typename L, typename Out, typename... Data>
+void parallel_compute(executor& ex, L const& lambda, size_t count, Out out, Data const&... input) noexcept
+{
+    constexpr size_t item_bytes = (sizeof(detail::batch_input_t<Out>) + ... + detail::batch_stride<Data>());
+
+    size_t chunk = ex.chunk_bytes() / item_bytes / detail::batch_width * detail::batch_width;
+    chunk        = std::max(chunk, detail::batch_width);
+
+    ex.run((count + chunk - 1) / chunk, [&](size_t index) {
+        size_t first = index * chunk;
+        size_t size  = std::min(chunk, count - first);
+        compute_batch<Opts...>(lambda, size, detail::batch_offset(out, first), detail::batch_offset(input, first)...);
+    });
+}
+
+// Evaluate a compiled kernel in parallel (see `compile`)
+template <typename L, typename... Opts, typename... Data, typename Out, typename... In>
+void parallel_compute(executor& ex,
+                      kernel<L, std::tuple<Opts...>, Data...> const& k,
+                      size_t count,
+                      Out out,
+                      In const&... input) noexcept
+{
+    static_assert(sizeof...(In) == sizeof...(Data), "Parallel kernel invoked with the wrong number of inputs.");
+    parallel_compute<Opts...>(ex, k.lambda, count, out, input...);
+}
+} // namespace gal
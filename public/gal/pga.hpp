@@ -245,7 +245,7 @@ namespace pga {
         [[nodiscard]] constexpr static auto ie(uint32_t id) noexcept
         {
             return detail::construct_ie<algebra_t>(
-                id, std::make_integer_sequence<width_t, 4>{}, std::integer_sequence<uint8_t, 0b1, 0b10, 0b100, 0b1000>{});
+                id, std::make_integer_sequence<width_t, 4>{}, std::integer_sequence<pga_algebra::blade_t, 0b1, 0b10, 0b100, 0b1000>{});
         }
 
         [[nodiscard]] constexpr static size_t size() noexcept
@@ -265,7 +265,7 @@ namespace pga {
             , z{z}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr plane(entity<pga_algebra, T, E...> in) noexcept
             : data{in.template select<0b1, 0b10, 0b100, 0b1000>()}
         {
@@ -340,7 +340,7 @@ namespace pga {
             , z{z}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr point(entity<pga_algebra, T, E...> in) noexcept
             : data{}
         {
@@ -386,7 +386,7 @@ namespace pga {
         // Like planes, points are represented dually as the intersection of three planes
         [[nodiscard]] constexpr static mv<algebra_t, 3, 3, 3> ie(uint32_t id) noexcept
         {
-            return {mv_size{3, 4, 4},
+            return {mv_size{3, 3, 3},
                     {
                         ind{id + 2, one}, // -z
                         ind{id + 1, one}, // y
@@ -420,7 +420,7 @@ namespace pga {
             , z{z}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr vector(entity<pga_algebra, T, E...> in) noexcept
             : data{}
         {
@@ -517,9 +517,9 @@ namespace pga {
             , mz{mz}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr line(entity<pga_algebra, T, E...> in) noexcept
-            : data{in.template select<0b11, 0b101, 0b100, 0b1001, 0b1010, 0b1100>()}
+            : data{in.template select<0b1100, 0b1010, 0b110, 0b11, 0b101, 0b1001>()}
         {}
 
         constexpr line(std::array<T, 6> in) noexcept
@@ -543,71 +543,147 @@ namespace pga {
         }
     };
 
-    // A bivector has a closed-form exponential solution which can be used to produce a motor
+    // A bivector has a closed-form exponential solution which can be used to produce a motor (see `versor_exp`)
     template <typename T>
     [[nodiscard]] constexpr motor<T> exp(line<T> const& l) noexcept
     {
-        // We need to decompose the line l into two parts which scale the normalized euclidean and ideal components of
-        // the line L.
-        // L being a bivector squares to produce a quantity of the form L^2 = s + p * I.
-        // norm = sqrt(-L^2) = sqrt(-s - p * I) = sqrt(-s) + p * sqrt(-s) / (2s) * I
-        // The inverse of the norm is given by norm_inv = 1/sqrt(-s) - p / sqrt(-s) * I
-        // So L_norm can be written as norm_inv * L
-        auto l2 = compute([](auto l) { return l * l; }, l);
-        static_assert(l2.size() == 2);
-        auto s = -l2[0];
-        auto u = std::sqrt(s);
-        auto v = -l2[1] / (2 * u);
-        l2[0]  = u;
-        l2[1]  = v;
-
-        decltype(l2) inv_norm{T{1} / u, -l2[1] / s};
-        auto cos_u = std::cos(u);
-        auto sin_u = std::sin(u);
-        decltype(l2) real{cos_u, -v * sin_u};
-        decltype(l2) ideal{sin_u, v * cos_u};
-        return compute([](auto real, auto ideal, auto inv_norm, auto l) { return real + ideal * inv_norm * l; },
-                       real,
-                       ideal,
-                       inv_norm,
-                       l);
+        return compute([](auto l) { return versor_exp(l); }, l);
     }
 
-    // A closed-form solution of the logarithm of an element of the even subalgebra also exists
+    // A closed-form solution of the logarithm of a normalized element of the even subalgebra also exists (see
+    // `versor_log`)
     template <typename T>
     [[nodiscard]] constexpr line<T> log(motor<T> const& m) noexcept
     {
-        // When normalized, the motor has the form <m>_0 + <m>_2 + <m>4
-        // m := s1 + L + p1 * I
-        // Decompose L into L = (s2 + p2 * I) * L_norm => m = s1 + p1 * I + (s2 + p2 * I) * L_norm
-        // The norm is computed as above with norm = sqrt(-s2) + p2/(2 * sqrt(-s2)) * I
-        // so norm_inv is 1/sqrt(-s2) + p2/sqrt(-s2) * I
-        // The exponential has the form (cosu - vsinu * I) + (sinu + vcosu * I) * L_norm = e^((u + v*I) * L_norm)
-        // Comparing the two equations leads to:
-        // s1 = cosu
-        // p2 = vcosu
-        // s2 = sinu
-        // p1 = -vsinu
-        //
-        // If s1 isn't 0, we can solve for u as arctan(s2/s1) and v = p2/s1 using the first 2 equations
-        // If s1 is 0, we take instead the second and fourth equation so u = arctan(-p2/p1) and v = -p1/s2
-        auto s1 = m[0]; // <m>_0
-        auto p1 = m[7]; // <m>_4
-
-        line<T> l{m.template select<0b11, 0b101, 0b110, 0b1001, 0b1010, 0b1100>()};
-        // s + p * I
-        auto l2 = compute([](auto l) { return l * l; }, l);
-        static_assert(l2.size() == 2);
-        auto s2 = std::sqrt(-l2[0]);
-        auto p2 = -l2[1] / (2 * s2);
-
-        bool s1_zero = std::abs(s1) < T{1e-6};
-
-        scalar<pga_algebra, T> u{s1_zero ? std::atan2(-p1, p2) : std::atan2(s2, s1)};
-        scalar<pga_algebra, T> v{s1_zero ? -p1 / s2 : p2 / s1};
-        decltype(l2) norm_inv{-s2, p2 / (2 * s2)};
-        return compute(
-            [](auto norm_inv, auto l, auto u, auto v) { return (u + v * ps<T>)*norm_inv * l; }, norm_inv, l, u, v);
+        return compute([](auto m) { return versor_log(m); }, m);
+    }
+
+    // Exponentials of `count` lines, with each component of the lines and motors held in an array of its own. The batch
+    // is evaluated with the approximations of `fp::approx` so that the sines, cosines and square roots are vectorized
+    // across lines.
+    template <typename T, typename In>
+    void exp(size_t count, soa<motor<T>> out, soa<In> in) noexcept
+    {
+        static_assert(std::is_same_v<std::remove_const_t<In>, line<T>>, "Mismatched value types.");
+        compute_batch<opt::cse, fp::approx>([](auto l) { return versor_exp(l); }, count, out, in);
+    }
+
+    // Logarithms of `count` normalized motors held as structure-of-arrays, evaluated as with the batched `exp`
+    template <typename T, typename In>
+    void log(size_t count, soa<line<T>> out, soa<In> in) noexcept
+    {
+        static_assert(std::is_same_v<std::remove_const_t<In>, motor<T>>, "Mismatched value types.");
+        compute_batch<opt::cse, fp::approx>([](auto m) { return versor_log(m); }, count, out, in);
+    }
+
+    // The 3x4 row-major matrix [R | t] of the rigid motion applied by the sandwich p % m, which maps the point p to
+    // R p + t. The columns are the images of the ideal points along the axes and of the origin, which enter the reified
+    // sandwiches as constants so that only the terms quadratic in the motor remain. The weight picked up by the origin
+    // is divided out so that motors need not be normalized.
+    template <typename T>
+    [[nodiscard]] std::array<T, 12> to_matrix(motor<T> const& m) noexcept
+    {
+        auto [ex, ey, ez, origin] = compute(
+            [](auto m, auto ex, auto ey, auto ez, auto origin) {
+                return std::make_tuple(ex % m, ey % m, ez % m, origin % m);
+            },
+            m,
+            constant<vector<T>, 1, 0, 0>{},
+            constant<vector<T>, 0, 1, 0>{},
+            constant<vector<T>, 0, 0, 1>{},
+            constant<point<T>, 0, 0, 0>{});
+
+        T w_inv = T{1} / origin.template select<0b1110>()[0];
+        vector<T> x{ex};
+        vector<T> y{ey};
+        vector<T> z{ez};
+        vector<T> t{origin};
+        return {x.x * w_inv, y.x * w_inv, z.x * w_inv, t.x * w_inv,
+                x.y * w_inv, y.y * w_inv, z.y * w_inv, t.y * w_inv,
+                x.z * w_inv, y.z * w_inv, z.z * w_inv, t.z * w_inv};
+    }
+
+    // The normalized motor applying the rigid motion given by a 3x4 row-major matrix [R | t], where R is a rotation.
+    // The rotation is converted to a quaternion by the method of Shepperd (dividing by the largest of its four squared
+    // components) and the motor is the product of the translation by t and that rotor. Of the two motors m and -m
+    // performing the motion, the one with a non-negative scalar is returned.
+    template <typename T>
+    [[nodiscard]] motor<T> from_matrix(std::array<T, 12> const& matrix) noexcept
+    {
+        auto r = [&matrix](int row, int column) { return matrix[4 * row + column]; };
+
+        // The quaternion w + xi + yj + zk of R
+        T w;
+        T x;
+        T y;
+        T z;
+        T trace = r(0, 0) + r(1, 1) + r(2, 2);
+        if (trace > T{0})
+        {
+            T s = T{2} * std::sqrt(trace + T{1});
+            w   = T{0.25} * s;
+            x   = (r(2, 1) - r(1, 2)) / s;
+            y   = (r(0, 2) - r(2, 0)) / s;
+            z   = (r(1, 0) - r(0, 1)) / s;
+        }
+        else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2))
+        {
+            T s = T{2} * std::sqrt(T{1} + r(0, 0) - r(1, 1) - r(2, 2));
+            w   = (r(2, 1) - r(1, 2)) / s;
+            x   = T{0.25} * s;
+            y   = (r(0, 1) + r(1, 0)) / s;
+            z   = (r(0, 2) + r(2, 0)) / s;
+        }
+        else if (r(1, 1) > r(2, 2))
+        {
+            T s = T{2} * std::sqrt(T{1} + r(1, 1) - r(0, 0) - r(2, 2));
+            w   = (r(0, 2) - r(2, 0)) / s;
+            x   = (r(0, 1) + r(1, 0)) / s;
+            y   = T{0.25} * s;
+            z   = (r(1, 2) + r(2, 1)) / s;
+        }
+        else
+        {
+            T s = T{2} * std::sqrt(T{1} + r(2, 2) - r(0, 0) - r(1, 1));
+            w   = (r(1, 0) - r(0, 1)) / s;
+            x   = (r(0, 2) + r(2, 0)) / s;
+            y   = (r(1, 2) + r(2, 1)) / s;
+            z   = T{0.25} * s;
+        }
+        if (w < T{0})
+        {
+            w = -w;
+            x = -x;
+            y = -y;
+            z = -z;
+        }
+
+        // The bivectors e23, e31 and e12 rotate opposite to the quaternion units i, j and k under the sandwich
+        motor<T> rotor{w, 0, 0, -z, 0, y, -x, 0};
+        motor<T> translator{1, T{-0.5} * r(0, 3), T{-0.5} * r(1, 3), 0, T{-0.5} * r(2, 3), 0, 0, 0};
+        return compute([](auto translator, auto rotor) { return translator * rotor; }, translator, rotor);
+    }
+
+    // Transform `count` points by the matrix of a rigid motion (see `to_matrix`), with 9 multiply-adds per point. `out`
+    // may equal `in`.
+    template <typename T>
+    void transform(size_t count, point<T>* out, point<T> const* in, std::array<T, 12> const& matrix) noexcept
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            point<T> p = in[i];
+            out[i]     = point<T>{matrix[0] * p.x + matrix[1] * p.y + matrix[2] * p.z + matrix[3],
+                              matrix[4] * p.x + matrix[5] * p.y + matrix[6] * p.z + matrix[7],
+                              matrix[8] * p.x + matrix[9] * p.y + matrix[10] * p.z + matrix[11]};
+        }
+    }
+
+    // Apply the motor m to `count` points. Each sandwich p % m is quadratic in the motor, so the motor is compiled to
+    // its matrix once and the points are streamed through it.
+    template <typename T>
+    void transform(size_t count, point<T>* out, point<T> const* in, motor<T> const& m) noexcept
+    {
+        transform(count, out, in, to_matrix(m));
     }
 } // namespace pga
 } // namespace gal
\ No newline at end of file
@@ -47,7 +47,7 @@ namespace pga
         [[nodiscard]] constexpr static auto ie(uint32_t id) noexcept
         {
             return detail::construct_ie<algebra_t>(
-                id, std::make_integer_sequence<width_t, 4>{}, std::integer_sequence<uint8_t, 0b1, 0b10, 0b100>{});
+                id, std::make_integer_sequence<width_t, 4>{}, std::integer_sequence<pga_algebra::blade_t, 0b1, 0b10, 0b100>{});
         }
 
         [[nodiscard]] constexpr static size_t size() noexcept
@@ -66,7 +66,7 @@ namespace pga
             , y{c}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr line(entity<pga_algebra, T, E...> in) noexcept
             : data{in.template select<0b1, 0b10, 0b100>()}
         {}
@@ -146,7 +146,7 @@ namespace pga
             , y{y}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr point(entity<pga_algebra, T, E...> in) noexcept
         {
             auto input = in.template select<0b11, 0b101, 0b110>();
@@ -224,7 +224,7 @@ namespace pga
             , z{z}
         {}
 
-        template <uint8_t... E>
+        template <typename pga_algebra::blade_t... E>
         constexpr vector(entity<pga_algebra, T, E...> in) noexcept
         {
             auto input = in.template select<0b111, 0b1011, 0b1101>();
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "parallel.hpp"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Pipelines evaluate a graph of dependent computations for many independent instances (e.g. the inverse kinematics of
+// thousands of robot arms). Each stage is described once with `stage(lambda).after(inputs...)` where the inputs are
+// earlier stages, per-instance arrays (`source`), or entities shared by all instances. Running the pipeline evaluates
+// the stages in dependency order, each one as a batch over many instances (see `compute_batch`) on the threads of an
+// `executor`, so that a chain of small scalar computations per instance becomes a short sequence of vectorized sweeps.
+//
+// Stages are identified by their type, so a stage reached along several paths is evaluated once. Two stages holding
+// runtime values (a capturing lambda or an entity broadcast to every instance) can have the same type and yet compute
+// different results; such stages must be told apart with an explicit id, `stage<Id>(lambda)`.
+
+namespace gal
+{
+// The I-th array passed to `pipeline::run`, holding one entity of type T per instance
+template <size_t I, typename T>
+struct source
+{
+    constexpr static size_t index = I;
+    using type                    = T;
+};
+
+template <size_t Id, typename L, typename... Inputs>
+struct pipeline_stage
+{
+    L lambda;
+    std::tuple<Inputs...> inputs;
+
+    // The arguments of the lambda, in order
+    template <typename... In>
+    [[nodiscard]] constexpr pipeline_stage<Id, L, In...> after(In const&... in) const noexcept
+    {
+        static_assert(sizeof...(Inputs) == 0, "The inputs of a stage may only be specified once.");
+        return {lambda, {in...}};
+    }
+};
+
+// Describe a pipeline stage evaluating the lambda (or compiled kernel, see `compile`). Stages of the same type and Id are
+// the same stage.
+template <size_t Id = 0, typename L>
+[[nodiscard]] constexpr pipeline_stage<Id, L> stage(L lambda) noexcept
+{
+    return {lambda, {}};
+}
+
+namespace detail
+{
+    template <typename T>
+    struct is_pipeline_stage
+    {
+        constexpr static bool value = false;
+    };
+
+    template <size_t Id, typename L, typename... Inputs>
+    struct is_pipeline_stage<pipeline_stage<Id, L, Inputs...>>
+    {
+        constexpr static bool value = true;
+    };
+
+    template <typename T>
+    struct is_source
+    {
+        constexpr static bool value = false;
+    };
+
+    template <size_t I, typename T>
+    struct is_source<source<I, T>>
+    {
+        constexpr static bool value = true;
+    };
+
+    template <typename T>
+    struct is_kernel
+    {
+        constexpr static bool value = false;
+    };
+
+    template <typename L, typename Opts, typename... Data>
+    struct is_kernel<kernel<L, Opts, Data...>>
+    {
+        constexpr static bool value = true;
+    };
+
+    // The entity produced by a single evaluation of L
+    template <typename L, typename... Data>
+    struct stage_result
+    {
+        using type = decltype(compute(std::declval<L const&>(), std::declval<Data const&>()...));
+    };
+
+    template <typename L, typename... Opts, typename... KData, typename... Data>
+    struct stage_result<kernel<L, std::tuple<Opts...>, KData...>, Data...>
+    {
+        using type = typename kernel<L, std::tuple<Opts...>, KData...>::result_t;
+    };
+
+    // The entity an input of a stage provides per instance. Anything other than a stage or source is broadcast.
+    template <typename T>
+    struct pipeline_element
+    {
+        using type = T;
+    };
+
+    template <size_t I, typename T>
+    struct pipeline_element<source<I, T>>
+    {
+        using type = T;
+    };
+
+    template <size_t Id, typename L, typename... Inputs>
+    struct pipeline_element<pipeline_stage<Id, L, Inputs...>>
+    {
+        using type = typename stage_result<L, typename pipeline_element<Inputs>::type...>::type;
+        static_assert(!is_tuple_v<type>, "Pipeline stages must return a single result.");
+    };
+
+    // The stages reachable from Ts appended to Order such that every stage follows its inputs. Stages are identified
+    // by type, so a stage reached along several paths is evaluated once.
+    template <typename Order, typename... Ts>
+    struct pipeline_order
+    {
+        using type = Order;
+    };
+
+    template <typename Order, typename T>
+    struct pipeline_visit
+    {
+        using type = Order;
+    };
+
+    template <typename Order, size_t Id, typename L, typename... Inputs>
+    struct pipeline_visit<Order, pipeline_stage<Id, L, Inputs...>>
+    {
+        using type = typename stage_append<pipeline_stage<Id, L, Inputs...>,
+                                           typename pipeline_order<Order, Inputs...>::type>::type;
+    };
+
+    template <typename Order, typename T, typename... Ts>
+    struct pipeline_order<Order, T, Ts...>
+    {
+        using type = typename pipeline_order<typename pipeline_visit<Order, T>::type, Ts...>::type;
+    };
+
+    // Whether an object of type T holds values known only at runtime. Stages and sources are accounted for separately.
+    template <typename T>
+    struct holds_values
+    {
+        constexpr static bool value = !std::is_empty_v<T>;
+    };
+
+    template <typename L, typename Opts, typename... Data>
+    struct holds_values<kernel<L, Opts, Data...>>
+    {
+        constexpr static bool value = !std::is_empty_v<L>;
+    };
+
+    template <size_t I, typename T>
+    struct holds_values<source<I, T>>
+    {
+        constexpr static bool value = false;
+    };
+
+    template <size_t Id, typename L, typename... Inputs>
+    struct holds_values<pipeline_stage<Id, L, Inputs...>>
+    {
+        constexpr static bool value = false;
+    };
+
+    // Whether the stage S cannot be identified by its type alone
+    template <typename S>
+    struct ambiguous_stage;
+
+    template <size_t Id, typename L, typename... Inputs>
+    struct ambiguous_stage<pipeline_stage<Id, L, Inputs...>>
+    {
+        constexpr static bool value = Id == 0 && (holds_values<L>::value || ... || holds_values<Inputs>::value);
+    };
+
+    // Number of paths from T to the stage S
+    template <typename S, typename T>
+    struct stage_occurrences
+    {
+        constexpr static size_t value = 0;
+    };
+
+    template <typename S, size_t Id, typename L, typename... Inputs>
+    struct stage_occurrences<S, pipeline_stage<Id, L, Inputs...>>
+    {
+        constexpr static size_t value
+            = std::is_same_v<S, pipeline_stage<Id, L, Inputs...>> + (stage_occurrences<S, Inputs>::value + ... + 0);
+    };
+
+    // Whether the stage S is reached along a single path from Outputs, or else is identified by its type
+    template <typename S, typename... Outputs>
+    struct unambiguous_stage
+    {
+        constexpr static bool value
+            = !ambiguous_stage<S>::value || (stage_occurrences<S, Outputs>::value + ... + 0) == 1;
+    };
+
+    template <typename Order, typename... Outputs>
+    struct unambiguous_order;
+
+    template <typename... S, typename... Outputs>
+    struct unambiguous_order<std::tuple<S...>, Outputs...>
+    {
+        constexpr static bool value = (unambiguous_stage<S, Outputs...>::value && ...);
+    };
+
+    template <typename Order>
+    struct pipeline_buffers;
+
+    template <typename... S>
+    struct pipeline_buffers<std::tuple<S...>>
+    {
+        using type = std::tuple<std::vector<typename pipeline_element<S>::type>...>;
+
+        // Bytes of intermediate results written per instance
+        constexpr static size_t instance_bytes = (sizeof(typename pipeline_element<S>::type) + ... + 0);
+    };
+} // namespace detail
+
+// A graph of stages ending in the stages Outputs. The results of every stage are held in buffers owned by the pipeline
+// which are reused across runs. Create pipelines with `make_pipeline`.
+template <typename... Outputs>
+struct pipeline
+{
+    // All stages in evaluation order
+    using order_t                       = typename detail::pipeline_order<std::tuple<>, Outputs...>::type;
+    constexpr static size_t stage_count = std::tuple_size_v<order_t>;
+
+    static_assert(detail::unambiguous_order<order_t, Outputs...>::value,
+                  "Stages of the same type which hold runtime values (captures or broadcast entities) cannot be told "
+                  "apart. Identify each with an explicit id: stage<Id>(lambda).");
+
+    explicit pipeline(Outputs const&... outputs)
+        : outputs_{outputs...}
+    {}
+
+    // Evaluate every stage for `count` instances. The i-th source reads from `arrays[i]`, a pointer to (or `strided`
+    // view of) `count` entities.
+    // Instances are split into chunks whose intermediate results fit within the executor's chunk size. Each chunk runs
+    // every stage in turn (as a batch over the instances of the chunk), so intermediates are consumed while they are
+    // still in cache, and chunks are spread over the threads of the executor.
+    template <typename... Arrays>
+    void run(executor& ex, size_t count, Arrays const&... arrays)
+    {
+        std::apply([count](auto&... buffer) { (buffer.resize(count), ...); }, buffers_);
+
+        constexpr size_t instance_bytes = detail::pipeline_buffers<order_t>::instance_bytes;
+
+        size_t chunk = ex.chunk_bytes() / instance_bytes / detail::batch_width * detail::batch_width;
+        chunk        = std::max(chunk, detail::batch_width);
+
+        auto sources = std::forward_as_tuple(arrays...);
+        ex.run((count + chunk - 1) / chunk, [&](size_t index) {
+            size_t first = index * chunk;
+            size_t size  = std::min(chunk, count - first);
+
+            std::array<bool, stage_count> done{};
+            std::apply([&](auto const&... out) { (evaluate(done, sources, first, size, out), ...); }, outputs_);
+        });
+    }
+
+    // The results of the stage for each instance of the last run
+    template <size_t Id, typename L, typename... Inputs>
+    [[nodiscard]] auto const* result(pipeline_stage<Id, L, Inputs...> const&) const noexcept
+    {
+        constexpr size_t index = detail::stage_index<pipeline_stage<Id, L, Inputs...>, order_t>::value;
+        static_assert(index < stage_count, "The stage is not part of this pipeline.");
+        return std::get<index>(buffers_).data();
+    }
+
+    // The results of the I-th output stage for each instance of the last run
+    template <size_t I>
+    [[nodiscard]] auto const* result() const noexcept
+    {
+        return result(std::get<I>(outputs_));
+    }
+
+private:
+    // Evaluate the stage (after its inputs) for the instances [first, first + size)
+    template <typename Sources, size_t Id, typename L, typename... Inputs>
+    void evaluate(std::array<bool, stage_count>& done,
+                  Sources const& sources,
+                  size_t first,
+                  size_t size,
+                  pipeline_stage<Id, L, Inputs...> const& s)
+    {
+        constexpr size_t index = detail::stage_index<pipeline_stage<Id, L, Inputs...>, order_t>::value;
+        if (done[index])
+        {
+            return;
+        }
+
+        std::apply(
+            [&](auto const&... in) {
+                (prepare(done, sources, first, size, in), ...);
+
+                auto* out = std::get<index>(buffers_).data() + first;
+                if constexpr (detail::is_kernel<L>::value)
+                {
+                    s.lambda(size, out, argument(sources, first, in)...);
+                }
+                else
+                {
+                    compute_batch(s.lambda, size, out, argument(sources, first, in)...);
+                }
+            },
+            s.inputs);
+        done[index] = true;
+    }
+
+    template <typename Sources, typename T>
+    void prepare(std::array<bool, stage_count>& done, Sources const& sources, size_t first, size_t size, T const& in)
+    {
+        if constexpr (detail::is_pipeline_stage<T>::value)
+        {
+            evaluate(done, sources, first, size, in);
+        }
+    }
+
+    template <typename Sources, typename T>
+    [[nodiscard]] auto argument(Sources const& sources, size_t first, T const& in) const noexcept
+    {
+        if constexpr (detail::is_pipeline_stage<T>::value)
+        {
+            constexpr size_t index = detail::stage_index<T, order_t>::value;
+            using element_t        = typename detail::pipeline_element<T>::type;
+            return static_cast<element_t const*>(std::get<index>(buffers_).data() + first);
+        }
+        else if constexpr (detail::is_source<T>::value)
+        {
+            static_assert(T::index < std::tuple_size_v<Sources>, "A source is missing from the arrays of the run.");
+            using array_t = std::decay_t<std::tuple_element_t<T::index, Sources>>;
+            static_assert(std::is_same_v<detail::batch_input_t<array_t>, typename T::type>,
+                          "The array passed for a source does not hold entities of the source's type.");
+            return detail::batch_offset(std::get<T::index>(sources), first);
+        }
+        else
+        {
+            return in;
+        }
+    }
+
+    std::tuple<Outputs...> outputs_;
+    typename detail::pipeline_buffers<order_t>::type buffers_;
+};
+
+// Create a pipeline evaluating the given stages and every stage they depend on
+template <typename... Outputs>
+[[nodiscard]] pipeline<Outputs...> make_pipeline(Outputs const&... outputs)
+{
+    return pipeline<Outputs...>{outputs...};
+}
+} // namespace gal
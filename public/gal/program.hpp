@@ -0,0 +1,1275 @@
+#pragma once
+
+#include "algebra.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+// Lowering of reified multivector tables into straight-line programs which may be optimized before evaluation
+
+namespace gal
+{
+// Optimization policies accepted by `compute` as explicit template arguments, e.g. `compute<opt::cse>(lambda, ...)`.
+// By default, every monomial of the reified expression is evaluated independently.
+namespace opt
+{
+    // Common subexpression elimination. Products of indeterminates shared by multiple monomials (across all terms) are
+    // computed once and reused.
+    struct cse
+    {};
+
+    // Rewrite each term in nested (multivariate Horner) form, e.g. a*x*y + a*x*z -> a*x*(y + z). This typically
+    // performs the fewest multiplies but lengthens dependency chains. Takes precedence over `cse` if both are supplied.
+    struct factor
+    {};
+} // namespace opt
+
+// Floating point evaluation policies, accepted alongside those of the `opt` namespace
+namespace fp
+{
+    // Accumulate each term as a chain of fused multiply-adds (`std::fma`), ordered so that the monomials which take
+    // longest to compute join the chain last. Combined with `opt::cse` or `opt::factor`, additions of products are
+    // contracted instead. Only profitable when the target has FMA instructions (e.g. compiling with -mfma), as
+    // `std::fma` is otherwise emulated in software.
+    struct fma
+    {};
+
+    // Evaluate the sine, cosine, arctangent and square root of staged subexpressions with the branch-free
+    // approximations of approx.hpp rather than the standard library, so that batches (see `compute_batch`) evaluate
+    // them vectorized across lanes instead of one call per lane. Results differ from the standard library in the last
+    // bit or two.
+    struct approx
+    {};
+} // namespace fp
+
+// Arithmetic cost of evaluating a kernel. Divisions and calls to fractional powers are tallied as multiplies and
+// negations are considered free. A fused multiply-add counts as one multiply and one addition but a single step of
+// depth. The depth is the number of operations on the longest dependency chain.
+struct op_count
+{
+    width_t multiplies = 0;
+    width_t additions  = 0;
+    width_t depth      = 0;
+};
+
+// Shape and cost of a kernel (see `kernel_stats`). The degree of a monomial is the sum of the exponents of its
+// indeterminates, rounded up.
+struct kernel_stats_t
+{
+    width_t terms      = 0;
+    width_t monomials  = 0;
+    width_t multiplies = 0;
+    width_t additions  = 0;
+    width_t depth      = 0;
+    width_t max_degree = 0;
+};
+
+// Cost of a kernel evaluated without optimization policies and after common subexpression elimination
+struct cse_stats
+{
+    op_count before;
+    op_count after;
+};
+
+namespace detail
+{
+    template <typename O, typename... Opts>
+    constexpr inline bool has_opt_v = (std::is_same_v<O, Opts> || ...);
+
+    // Whether the policies call for evaluation by a lowered program rather than monomial by monomial
+    template <typename... Opts>
+    constexpr inline bool lowers_v = has_opt_v<opt::cse, Opts...> || has_opt_v<opt::factor, Opts...>;
+
+    enum class instr_op : uint8_t
+    {
+        load,     // indeterminate a
+        pow,      // indeterminate a raised to the power q
+        mul,      // slot a * slot b
+        add,      // slot a + slot b
+        sub,      // slot a - slot b
+        scale,    // q * slot a
+        constant, // q
+        fma,      // slot a * slot b + slot c
+        fms,      // slot a * slot b - slot c
+        fnma,     // slot c - slot a * slot b
+    };
+
+    struct instr
+    {
+        instr_op op = instr_op::constant;
+        width_t a   = 0;
+        width_t b   = 0;
+        rat q;
+        width_t c = 0;
+    };
+
+    // Number of multiplies needed by `::gal::pow` to raise an indeterminate to the supplied degree
+    [[nodiscard]] constexpr width_t pow_cost(rat degree) noexcept
+    {
+        if (degree.den == 2)
+        {
+            return 1 + pow_cost({degree.num, 1});
+        }
+        else if (degree.den != 1)
+        {
+            return 1;
+        }
+
+        width_t out = degree.num < 0 ? 1 : 0;
+        auto e      = static_cast<uint32_t>(degree.num < 0 ? -degree.num : degree.num);
+        if (e > 1)
+        {
+            out += leading_set_index(e) + pop_count(e) - 1;
+        }
+        return out;
+    }
+
+    [[nodiscard]] constexpr bool is_unit(rat q) noexcept
+    {
+        return q.den == 1 && (q.num == 1 || q.num == -1);
+    }
+
+    // Sentinel slot denoting the empty product
+    constexpr inline width_t unit_slot = ~0u;
+
+    // The distinct powers (other than the first) of indeterminates occurring in a table, each of which is evaluated
+    // once per invocation. slots[i] is the power read by the i-th indeterminate of the table, or `unit_slot` if the
+    // indeterminate is read directly.
+    template <width_t N>
+    struct power_table
+    {
+        width_t size = 0;
+        std::array<ind, N == 0 ? 1 : N> powers{};
+        std::array<width_t, N == 0 ? 1 : N> slots{};
+    };
+
+    template <typename T>
+    [[nodiscard]] constexpr auto make_power_table(T const& ie) noexcept
+    {
+        power_table<T::ind_capacity()> out;
+        for (auto& slot : out.slots)
+        {
+            slot = unit_slot;
+        }
+
+        for (width_t i = 0; i != ie.size.mon; ++i)
+        {
+            auto const& m = ie.mons[i];
+            for (width_t j = m.ind_offset; !m.q.is_zero() && j != m.ind_offset + m.count; ++j)
+            {
+                auto const& f = ie.inds[j];
+                if (f.degree.num == 1 && f.degree.den == 1)
+                {
+                    continue;
+                }
+
+                width_t k = 0;
+                while (k != out.size && (out.powers[k].id != f.id || out.powers[k].degree != f.degree))
+                {
+                    ++k;
+                }
+                if (k == out.size)
+                {
+                    out.powers[out.size++] = f;
+                }
+                out.slots[j] = k;
+            }
+        }
+        return out;
+    }
+
+    // A straight-line program in static single assignment form. Instruction i writes its result to slot i and output j
+    // reads slot outputs[j]. Loads (and powers) of indeterminates precede all arithmetic.
+    template <width_t S, width_t O>
+    struct program
+    {
+        width_t size = 0;
+        std::array<instr, S> instrs;
+        std::array<width_t, O> outputs;
+
+        constexpr width_t push(instr in) noexcept
+        {
+            instrs[size] = in;
+            return size++;
+        }
+
+        [[nodiscard]] constexpr op_count ops() const noexcept
+        {
+            op_count out;
+            std::array<width_t, S> depths{};
+            for (width_t i = 0; i != size; ++i)
+            {
+                auto const& in = instrs[i];
+                switch (in.op)
+                {
+                case instr_op::pow:
+                    out.multiplies += pow_cost(in.q);
+                    depths[i] = pow_cost(in.q);
+                    break;
+                case instr_op::mul:
+                    ++out.multiplies;
+                    depths[i] = 1 + (depths[in.a] > depths[in.b] ? depths[in.a] : depths[in.b]);
+                    break;
+                case instr_op::add:
+                case instr_op::sub:
+                    ++out.additions;
+                    depths[i] = 1 + (depths[in.a] > depths[in.b] ? depths[in.a] : depths[in.b]);
+                    break;
+                case instr_op::scale:
+                    out.multiplies += is_unit(in.q) ? 0 : 1;
+                    depths[i] = depths[in.a] + (is_unit(in.q) ? 0 : 1);
+                    break;
+                case instr_op::fma:
+                case instr_op::fms:
+                case instr_op::fnma:
+                    ++out.multiplies;
+                    ++out.additions;
+                    depths[i] = depths[in.a] > depths[in.b] ? depths[in.a] : depths[in.b];
+                    depths[i] = 1 + (depths[in.c] > depths[i] ? depths[in.c] : depths[i]);
+                    break;
+                default:
+                    break;
+                }
+            }
+            for (width_t i = 0; i != O; ++i)
+            {
+                out.depth = depths[outputs[i]] > out.depth ? depths[outputs[i]] : out.depth;
+            }
+            return out;
+        }
+    };
+
+    // Number of operations on the longest dependency chain producing a monomial, given that powers are evaluated up
+    // front
+    template <typename T>
+    [[nodiscard]] constexpr width_t mon_depth(T const& ie, mon const& m) noexcept
+    {
+        if (m.count == 0)
+        {
+            return 0;
+        }
+
+        width_t pow_depth = 0;
+        for (width_t i = m.ind_offset; i != m.ind_offset + m.count; ++i)
+        {
+            pow_depth = pow_cost(ie.inds[i].degree) > pow_depth ? pow_cost(ie.inds[i].degree) : pow_depth;
+        }
+        return pow_depth + m.count - 1 + (is_unit(m.q) ? 0 : 1);
+    }
+
+    // Whether accumulating the monomial into a sum needs a fused multiply-add (as opposed to a plain addition)
+    [[nodiscard]] constexpr bool is_fusable(mon const& m) noexcept
+    {
+        return m.count > 1 || (m.count == 1 && !is_unit(m.q));
+    }
+
+    // The monomials of the term starting at Offset in the order they join a chain of fused multiply-adds. Sorting by
+    // depth lets monomials which take longer to compute do so while the chain accumulates the others.
+    template <size_t N, typename T>
+    [[nodiscard]] constexpr std::array<width_t, N == 0 ? 1 : N> fma_order(T const& ie, width_t offset) noexcept
+    {
+        std::array<width_t, N == 0 ? 1 : N> out{};
+        std::array<width_t, N == 0 ? 1 : N> depths{};
+        for (width_t i = 0; i != N; ++i)
+        {
+            // Insertion sort keeps monomials of equal depth in table order
+            auto depth = mon_depth(ie, ie.mons[offset + i]);
+            width_t j  = i;
+            while (j > 0 && depths[j - 1] > depth)
+            {
+                out[j]    = out[j - 1];
+                depths[j] = depths[j - 1];
+                --j;
+            }
+            out[j]    = offset + i;
+            depths[j] = depth;
+        }
+        return out;
+    }
+
+    // Cost of evaluating the table monomial by monomial (see `cterm` and `cmon` in engine.hpp), optionally accumulating
+    // each term by a chain of fused multiply-adds. Powers are evaluated once up front and contribute to the depth of
+    // every monomial reading them.
+    template <typename T>
+    [[nodiscard]] constexpr op_count table_ops(T const& ie, bool fused = false) noexcept
+    {
+        op_count out;
+        auto powers = make_power_table(ie);
+        for (width_t i = 0; i != powers.size; ++i)
+        {
+            out.multiplies += pow_cost(powers.powers[i].degree);
+        }
+
+        constexpr width_t M = T::mon_capacity() == 0 ? 1 : T::mon_capacity();
+        std::array<width_t, M> depths{};
+        std::array<width_t, M> ready{};
+        for (auto term_it = ie.cbegin(); term_it != ie.cend(); ++term_it)
+        {
+            width_t mons = 0;
+            for (auto mon_it = term_it.cbegin(); mon_it != term_it.cend(); ++mon_it)
+            {
+                if (mon_it->q.is_zero())
+                {
+                    continue;
+                }
+
+                if (mon_it->count > 0)
+                {
+                    out.multiplies += mon_it->count - 1 + (is_unit(mon_it->q) ? 0 : 1);
+                }
+
+                // When fused, a link of the chain waits on the monomial less its final multiply. Links are ordered by
+                // depth as in `fma_order`.
+                auto depth = mon_depth(ie, *mon_it);
+                auto wait  = is_fusable(*mon_it) ? depth - 1 : depth;
+                width_t j  = mons++;
+                while (fused && j > 0 && depths[j - 1] > depth)
+                {
+                    depths[j] = depths[j - 1];
+                    ready[j]  = ready[j - 1];
+                    --j;
+                }
+                depths[j] = depth;
+                ready[j]  = wait;
+            }
+            out.additions += mons > 0 ? mons - 1 : 0;
+
+            width_t depth = 0;
+            for (width_t i = 0; i != mons; ++i)
+            {
+                width_t candidate = 0;
+                if (fused)
+                {
+                    candidate = i == 0 ? depths[i] : 1 + (ready[i] > depth ? ready[i] : depth);
+                }
+                else
+                {
+                    // Monomials are summed by a right fold, so the i-th monomial passes through min(i + 1, n - 1)
+                    // additions
+                    candidate = depths[i] + (i + 1 < mons - 1 ? i + 1 : mons - 1);
+                }
+                depth = candidate > depth ? candidate : depth;
+            }
+            out.depth = depth > out.depth ? depth : out.depth;
+        }
+        return out;
+    }
+
+    // Accumulate the number of terms, non-zero monomials, and the maximum monomial degree of the table into out
+    template <typename T>
+    constexpr void table_shape(T const& ie, kernel_stats_t& out) noexcept
+    {
+        out.terms += ie.size.term;
+        for (auto term_it = ie.cbegin(); term_it != ie.cend(); ++term_it)
+        {
+            for (auto mon_it = term_it.cbegin(); mon_it != term_it.cend(); ++mon_it)
+            {
+                if (mon_it->q.is_zero())
+                {
+                    continue;
+                }
+
+                ++out.monomials;
+                auto degree = mon_it->degree;
+                int ceiling = degree.num / degree.den + (degree.num > 0 && degree.num % degree.den != 0 ? 1 : 0);
+                if (ceiling > 0 && static_cast<width_t>(ceiling) > out.max_degree)
+                {
+                    out.max_degree = static_cast<width_t>(ceiling);
+                }
+            }
+        }
+    }
+
+    // Upper bound on the number of distinct pairs of factors drawn from the same monomial
+    template <typename T>
+    [[nodiscard]] constexpr width_t pair_capacity(T const& ie) noexcept
+    {
+        width_t out = 0;
+        for (width_t i = 0; i != ie.size.mon; ++i)
+        {
+            auto count = ie.mons[i].count;
+            out += count * (count - (count > 0 ? 1 : 0)) / 2;
+        }
+        return out;
+    }
+
+    struct factor_pair
+    {
+        width_t a;
+        width_t b;
+        width_t mon;
+    };
+
+    [[nodiscard]] constexpr bool operator<(factor_pair const& lhs, factor_pair const& rhs) noexcept
+    {
+        return lhs.a < rhs.a || (lhs.a == rhs.a && (lhs.b < rhs.b || (lhs.b == rhs.b && lhs.mon < rhs.mon)));
+    }
+
+    // A run of pairs [begin, end) sharing the same factors
+    struct pair_run
+    {
+        width_t begin;
+        width_t end;
+    };
+
+    // Factor slots of a monomial, stored in ascending order
+    struct factor_list
+    {
+        width_t* data;
+        width_t count;
+
+        [[nodiscard]] constexpr bool contains(width_t slot) const noexcept
+        {
+            for (width_t i = 0; i != count; ++i)
+            {
+                if (data[i] == slot)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Remove a single occurrence of the factor
+        constexpr void remove(width_t slot) noexcept
+        {
+            width_t i = 0;
+            while (data[i] != slot)
+            {
+                ++i;
+            }
+            for (; i + 1 < count; ++i)
+            {
+                data[i] = data[i + 1];
+            }
+            --count;
+        }
+
+        // Replace factors a and b with their product which, having been emitted last, occupies the highest slot
+        constexpr void replace(width_t a, width_t b, width_t product) noexcept
+        {
+            width_t j = 0;
+            for (width_t i = 0; i != count; ++i)
+            {
+                if (data[i] != a && data[i] != b)
+                {
+                    data[j++] = data[i];
+                }
+            }
+            data[j] = product;
+            count   = j + 1;
+        }
+    };
+
+    // The value of a slot multiplied by a rational coefficient
+    struct scaled_slot
+    {
+        width_t slot;
+        rat q;
+    };
+
+    [[nodiscard]] constexpr rat abs(rat in) noexcept
+    {
+        return {in.num < 0 ? -in.num : in.num, in.den};
+    }
+
+    // Emit the sum of the supplied slots with signs given by their coefficients. Returns the resulting slot and whether
+    // it must be negated.
+    template <typename P>
+    constexpr scaled_slot accumulate(P& out, scaled_slot const* first, scaled_slot const* last) noexcept
+    {
+        // Lead with a positive summand if possible so no negation is required
+        auto lead = first;
+        while (lead != last && lead->q.num < 0)
+        {
+            ++lead;
+        }
+        bool negate = lead == last;
+        if (negate)
+        {
+            lead = first;
+        }
+
+        width_t acc = lead->slot;
+        for (auto it = first; it != last; ++it)
+        {
+            if (it != lead)
+            {
+                acc = out.push({(it->q.num < 0) == negate ? instr_op::add : instr_op::sub, acc, it->slot, zero});
+            }
+        }
+        return {acc, negate ? minus_one : one};
+    }
+
+    // Emit the sum of coefficient-weighted slots. Summands sharing a coefficient magnitude are added first and scaled
+    // once. When all summands share a magnitude, it is returned unapplied so that the caller may factor it further.
+    template <typename P>
+    constexpr scaled_slot sum(P& out, scaled_slot* first, scaled_slot* last) noexcept
+    {
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->slot == unit_slot)
+            {
+                *it = {out.push({instr_op::constant, 0, 0, it->q}), one};
+            }
+        }
+
+        if (last - first == 1)
+        {
+            return *first;
+        }
+
+        heap_sort(first, last, [](scaled_slot const& lhs, scaled_slot const& rhs) {
+            auto lhs_q = abs(lhs.q);
+            auto rhs_q = abs(rhs.q);
+            return lhs_q < rhs_q || (!(rhs_q < lhs_q) && lhs.slot < rhs.slot);
+        });
+
+        // Partial sums are written back to the front of the range which is never ahead of the group being read
+        auto groups = first;
+        for (auto begin = first; begin != last;)
+        {
+            auto magnitude = abs(begin->q);
+            auto end       = begin + 1;
+            while (end != last && !(magnitude < abs(end->q)))
+            {
+                ++end;
+            }
+
+            auto partial = accumulate(out, begin, end);
+            partial.q    = partial.q * magnitude;
+            if (begin == first && end == last)
+            {
+                return partial;
+            }
+            else if (!is_unit(magnitude))
+            {
+                partial = {out.push({instr_op::scale, partial.slot, 0, magnitude}), partial.q.num < 0 ? minus_one : one};
+            }
+            *groups++ = partial;
+            begin     = end;
+        }
+
+        return accumulate(out, first, groups);
+    }
+
+    // Emit the product of the factors in the list
+    template <typename P>
+    constexpr width_t chain(P& out, factor_list const& list) noexcept
+    {
+        if (list.count == 0)
+        {
+            return unit_slot;
+        }
+
+        width_t acc = list.data[0];
+        for (width_t i = 1; i != list.count; ++i)
+        {
+            acc = out.push({instr_op::mul, acc, list.data[i], zero});
+        }
+        return acc;
+    }
+
+    // Apply the coefficient of a scaled slot
+    template <typename P>
+    constexpr width_t apply(P& out, scaled_slot in) noexcept
+    {
+        if (in.slot == unit_slot)
+        {
+            return out.push({instr_op::constant, 0, 0, in.q});
+        }
+        else if (in.q.num == 1 && in.q.den == 1)
+        {
+            return in.slot;
+        }
+        else
+        {
+            return out.push({instr_op::scale, in.slot, 0, in.q});
+        }
+    }
+
+    struct summand
+    {
+        factor_list list;
+        rat q;
+    };
+
+    // Recursive multivariate Horner scheme. The factor occurring in the most summands is pulled out of them
+    // (x*p + r) and both the quotient p and the remainder r are factored in turn. Summands without any shared factor
+    // are summed directly. `counts` is scratch space with an entry per factor slot (initially zero) and `scratch` holds
+    // at least as many entries as there are summands.
+    template <typename P>
+    constexpr scaled_slot
+    horner(P& out, summand* first, summand* last, width_t* counts, scaled_slot* scratch) noexcept
+    {
+        if (last - first == 1)
+        {
+            return {chain(out, first->list), first->q};
+        }
+
+        // Repeated factors (powers) are counted once per summand
+        for (auto it = first; it != last; ++it)
+        {
+            for (width_t i = 0; i != it->list.count; ++i)
+            {
+                if (i == 0 || it->list.data[i] != it->list.data[i - 1])
+                {
+                    ++counts[it->list.data[i]];
+                }
+            }
+        }
+        width_t best       = unit_slot;
+        width_t best_count = 1;
+        for (auto it = first; it != last; ++it)
+        {
+            for (width_t i = 0; i != it->list.count; ++i)
+            {
+                auto slot  = it->list.data[i];
+                auto count = counts[slot];
+                if (count > best_count || (count == best_count && count > 1 && slot < best))
+                {
+                    best       = slot;
+                    best_count = count;
+                }
+            }
+        }
+        for (auto it = first; it != last; ++it)
+        {
+            for (width_t i = 0; i != it->list.count; ++i)
+            {
+                counts[it->list.data[i]] = 0;
+            }
+        }
+
+        if (best == unit_slot)
+        {
+            auto scratch_end = scratch;
+            for (auto it = first; it != last; ++it)
+            {
+                *scratch_end++ = {chain(out, it->list), it->q};
+            }
+            return sum(out, scratch, scratch_end);
+        }
+
+        auto mid = first;
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->list.contains(best))
+            {
+                it->list.remove(best);
+                swap(*it, *mid++);
+            }
+        }
+
+        auto quotient = horner(out, first, mid, counts, scratch);
+        scaled_slot product{best, quotient.q};
+        if (quotient.slot != unit_slot)
+        {
+            product.slot = out.push({instr_op::mul, best, quotient.slot, zero});
+        }
+
+        if (mid == last)
+        {
+            return product;
+        }
+
+        std::array<scaled_slot, 2> operands{product, horner(out, mid, last, counts, scratch)};
+        return sum(out, operands.data(), operands.data() + 2);
+    }
+
+    // Number of factors after expanding positive integral powers into repeated factors
+    template <typename T>
+    [[nodiscard]] constexpr width_t expanded_capacity(T const& ie) noexcept
+    {
+        width_t out = 0;
+        for (width_t i = 0; i != ie.size.ind; ++i)
+        {
+            auto const& degree = ie.inds[i].degree;
+            out += degree.den == 1 && degree.num > 1 ? degree.num : 1;
+        }
+        return out;
+    }
+
+    enum class lowering : uint8_t
+    {
+        share,
+        cse,
+        factor,
+    };
+
+    // Lower the table to a program. Each distinct power of an indeterminate is loaded once. Then, depending on the mode:
+    //
+    // share:  Each distinct product of factors is computed once, regardless of how many monomials (in any term) it
+    //         appears in.
+    // cse:    Additionally, pairs of factors which occur together in multiple monomials are replaced by a temporary
+    //         holding their product. Pairs are extracted greedily in rounds, most frequent first, until no pair is
+    //         shared.
+    // factor: Powers are expanded into repeated factors and each term is rewritten in nested Horner form. This
+    //         minimizes multiplies within a term at the expense of longer dependency chains.
+    //
+    // Finally, the coefficients within each term are grouped by magnitude so that each distinct coefficient is applied
+    // once.
+    template <auto const& ie, lowering Mode>
+    [[nodiscard]] constexpr auto lower() noexcept
+    {
+        using table_t       = std::decay_t<decltype(ie)>;
+        constexpr width_t I = table_t::ind_capacity();
+        constexpr width_t M = table_t::mon_capacity();
+        constexpr width_t T = table_t::term_capacity();
+        constexpr width_t E = Mode == lowering::factor ? expanded_capacity(ie) : I;
+        constexpr width_t P = Mode == lowering::cse ? pair_capacity(ie) : 0;
+
+        // Every instruction beyond the loads either reduces the factor count of a monomial, or consumes a monomial or
+        // term when accumulating terms, so the capacity is bounded by the table size
+        program<I + 2 * E + 4 * M + 2 * T + 1, T> out{};
+
+        // Collect distinct factors
+        auto base = [](ind f) {
+            if constexpr (Mode == lowering::factor)
+            {
+                if (f.degree.den == 1 && f.degree.num > 1)
+                {
+                    return ind{f.id, one};
+                }
+            }
+            return f;
+        };
+        std::array<ind, I> factors{};
+        width_t factor_count = 0;
+        for (width_t i = 0; i != ie.size.mon; ++i)
+        {
+            auto const& m = ie.mons[i];
+            if (!m.q.is_zero())
+            {
+                for (width_t j = m.ind_offset; j != m.ind_offset + m.count; ++j)
+                {
+                    factors[factor_count++] = base(ie.inds[j]);
+                }
+            }
+        }
+        heap_sort(factors.begin(), factors.begin() + factor_count, [](ind lhs, ind rhs) { return lhs < rhs; });
+        width_t unique_count = 0;
+        for (width_t i = 0; i != factor_count; ++i)
+        {
+            if (i == 0 || factors[i] != factors[unique_count - 1])
+            {
+                factors[unique_count++] = factors[i];
+            }
+        }
+        for (width_t i = 0; i != unique_count; ++i)
+        {
+            auto const& f = factors[i];
+            if (f.degree.num == 1 && f.degree.den == 1)
+            {
+                out.push({instr_op::load, f.id, 0, zero});
+            }
+            else
+            {
+                out.push({instr_op::pow, f.id, 0, f.degree});
+            }
+        }
+
+        // Express each monomial as a list of factor slots
+        std::array<width_t, E> slots{};
+        std::array<factor_list, M> lists{};
+        width_t slot_offset = 0;
+        for (width_t i = 0; i != ie.size.mon; ++i)
+        {
+            auto const& m = ie.mons[i];
+            lists[i]      = {slots.data() + slot_offset, 0};
+            for (width_t j = 0; !m.q.is_zero() && j != m.count; ++j)
+            {
+                auto const& f = ie.inds[m.ind_offset + j];
+                auto key      = base(f);
+                width_t low   = 0;
+                width_t high  = unique_count;
+                while (high - low > 1)
+                {
+                    width_t mid = (low + high) / 2;
+                    if (key < factors[mid])
+                    {
+                        high = mid;
+                    }
+                    else
+                    {
+                        low = mid;
+                    }
+                }
+
+                auto repeat = key == f ? 1 : f.degree.num;
+                for (int k = 0; k != repeat; ++k)
+                {
+                    lists[i].data[lists[i].count++] = low;
+                }
+            }
+            slot_offset += lists[i].count;
+            sort(lists[i].data, lists[i].data + lists[i].count);
+        }
+
+        if constexpr (Mode == lowering::factor)
+        {
+            std::array<summand, M> summands{};
+            std::array<scaled_slot, M> scratch{};
+            std::array<width_t, I> counts{};
+            for (width_t i = 0; i != ie.size.term; ++i)
+            {
+                auto const& t = ie.terms[i];
+
+                width_t summand_count = 0;
+                for (width_t j = t.mon_offset; j != t.mon_offset + t.count; ++j)
+                {
+                    if (!ie.mons[j].q.is_zero())
+                    {
+                        summands[summand_count++] = {lists[j], ie.mons[j].q};
+                    }
+                }
+
+                out.outputs[i]
+                    = summand_count == 0
+                          ? out.push({instr_op::constant, 0, 0, zero})
+                          : apply(out,
+                                  horner(out,
+                                         summands.data(),
+                                         summands.data() + summand_count,
+                                         counts.data(),
+                                         scratch.data()));
+            }
+            return out;
+        }
+        else
+        {
+            std::array<factor_pair, P> pairs{};
+            std::array<pair_run, P> runs{};
+            while (Mode == lowering::cse)
+            {
+                width_t pair_count = 0;
+                for (width_t i = 0; i != ie.size.mon; ++i)
+                {
+                    auto const& list = lists[i];
+                    for (width_t j = 0; j + 1 < list.count; ++j)
+                    {
+                        for (width_t k = j + 1; k != list.count; ++k)
+                        {
+                            pairs[pair_count++] = {list.data[j], list.data[k], i};
+                        }
+                    }
+                }
+                heap_sort(pairs.begin(), pairs.begin() + pair_count, [](auto const& lhs, auto const& rhs) {
+                    return lhs < rhs;
+                });
+
+                width_t run_count = 0;
+                for (width_t begin = 0; begin != pair_count;)
+                {
+                    width_t end = begin + 1;
+                    while (end != pair_count && pairs[end].a == pairs[begin].a && pairs[end].b == pairs[begin].b)
+                    {
+                        ++end;
+                    }
+                    if (end - begin > 1)
+                    {
+                        runs[run_count++] = {begin, end};
+                    }
+                    begin = end;
+                }
+                heap_sort(runs.begin(), runs.begin() + run_count, [](pair_run const& lhs, pair_run const& rhs) {
+                    auto lhs_count = lhs.end - lhs.begin;
+                    auto rhs_count = rhs.end - rhs.begin;
+                    return lhs_count > rhs_count || (lhs_count == rhs_count && lhs.begin < rhs.begin);
+                });
+
+                // Monomials may have lost factors to more frequent pairs earlier in the round, so the number of monomials
+                // which can still share a run is recounted before committing to a temporary
+                width_t extracted = 0;
+                for (width_t i = 0; i != run_count; ++i)
+                {
+                    auto const& run = runs[i];
+                    auto a          = pairs[run.begin].a;
+                    auto b          = pairs[run.begin].b;
+                    width_t hits    = 0;
+                    for (width_t j = run.begin; j != run.end; ++j)
+                    {
+                        auto const& list = lists[pairs[j].mon];
+                        hits += list.contains(a) && list.contains(b) ? 1 : 0;
+                    }
+
+                    if (hits > 1)
+                    {
+                        auto product = out.push({instr_op::mul, a, b, zero});
+                        for (width_t j = run.begin; j != run.end; ++j)
+                        {
+                            auto& list = lists[pairs[j].mon];
+                            if (list.contains(a) && list.contains(b))
+                            {
+                                list.replace(a, b, product);
+                            }
+                        }
+                        ++extracted;
+                    }
+                }
+
+                if (extracted == 0)
+                {
+                    break;
+                }
+            }
+
+            // Identical products are adjacent once monomials are ordered by their factor lists
+            std::array<width_t, M> order{};
+            width_t product_count = 0;
+            for (width_t i = 0; i != ie.size.mon; ++i)
+            {
+                if (lists[i].count > 1)
+                {
+                    order[product_count++] = i;
+                }
+            }
+            heap_sort(order.begin(), order.begin() + product_count, [&lists](width_t lhs, width_t rhs) {
+                auto const& lhs_list = lists[lhs];
+                auto const& rhs_list = lists[rhs];
+                for (width_t i = 0; i != lhs_list.count && i != rhs_list.count; ++i)
+                {
+                    if (lhs_list.data[i] != rhs_list.data[i])
+                    {
+                        return lhs_list.data[i] < rhs_list.data[i];
+                    }
+                }
+                return lhs_list.count < rhs_list.count || (lhs_list.count == rhs_list.count && lhs < rhs);
+            });
+
+            std::array<width_t, M> products{};
+            for (width_t i = 0; i != product_count; ++i)
+            {
+                auto const& list = lists[order[i]];
+                if (i > 0)
+                {
+                    auto const& previous = lists[order[i - 1]];
+                    bool same            = previous.count == list.count;
+                    for (width_t j = 0; same && j != list.count; ++j)
+                    {
+                        same = previous.data[j] == list.data[j];
+                    }
+                    if (same)
+                    {
+                        products[order[i]] = products[order[i - 1]];
+                        continue;
+                    }
+                }
+                products[order[i]] = chain(out, list);
+            }
+
+            std::array<scaled_slot, M> summands{};
+            for (width_t i = 0; i != ie.size.term; ++i)
+            {
+                auto const& t = ie.terms[i];
+
+                width_t summand_count = 0;
+                for (width_t j = t.mon_offset; j != t.mon_offset + t.count; ++j)
+                {
+                    auto const& list = lists[j];
+                    if (!ie.mons[j].q.is_zero())
+                    {
+                        auto slot                 = list.count == 0 ? unit_slot : list.count == 1 ? list.data[0] : products[j];
+                        summands[summand_count++] = {slot, ie.mons[j].q};
+                    }
+                }
+
+                out.outputs[i] = summand_count == 0
+                                     ? out.push({instr_op::constant, 0, 0, zero})
+                                     : apply(out, sum(out, summands.data(), summands.data() + summand_count));
+            }
+            return out;
+        }
+    }
+
+    // The program evaluating table ie under the supplied optimization policies
+    template <typename... Opts>
+    constexpr inline lowering lowering_v = has_opt_v<opt::factor, Opts...> ? lowering::factor
+                                           : has_opt_v<opt::cse, Opts...> ? lowering::cse
+                                                                          : lowering::share;
+
+    // Contract each addition or subtraction of a product which is read nowhere else into a fused multiply-add. The
+    // product itself is left behind as a (free) constant so that slot numbering is unchanged.
+    template <width_t S, width_t O>
+    [[nodiscard]] constexpr program<S, O> contract(program<S, O> in) noexcept
+    {
+        std::array<width_t, S> uses{};
+        for (width_t i = 0; i != in.size; ++i)
+        {
+            auto const& x = in.instrs[i];
+            switch (x.op)
+            {
+            case instr_op::mul:
+            case instr_op::add:
+            case instr_op::sub:
+                ++uses[x.a];
+                ++uses[x.b];
+                break;
+            case instr_op::scale:
+                ++uses[x.a];
+                break;
+            default:
+                break;
+            }
+        }
+        for (width_t i = 0; i != O; ++i)
+        {
+            ++uses[in.outputs[i]];
+        }
+
+        auto fusable = [&in, &uses](width_t slot) {
+            return in.instrs[slot].op == instr_op::mul && uses[slot] == 1;
+        };
+        auto fuse = [&in](instr_op op, width_t product, width_t addend) {
+            instr out{op, in.instrs[product].a, in.instrs[product].b, zero, addend};
+            in.instrs[product] = {instr_op::constant, 0, 0, zero};
+            return out;
+        };
+
+        for (width_t i = 0; i != in.size; ++i)
+        {
+            auto& x = in.instrs[i];
+            if (x.op == instr_op::add && fusable(x.a))
+            {
+                x = fuse(instr_op::fma, x.a, x.b);
+            }
+            else if (x.op == instr_op::add && fusable(x.b))
+            {
+                x = fuse(instr_op::fma, x.b, x.a);
+            }
+            else if (x.op == instr_op::sub && fusable(x.a))
+            {
+                x = fuse(instr_op::fms, x.a, x.b);
+            }
+            else if (x.op == instr_op::sub && fusable(x.b))
+            {
+                x = fuse(instr_op::fnma, x.b, x.a);
+            }
+        }
+        return in;
+    }
+
+    template <auto const& ie, typename... Opts>
+    [[nodiscard]] constexpr auto make_program() noexcept
+    {
+        if constexpr (has_opt_v<fp::fma, Opts...>)
+        {
+            return contract(lower<ie, lowering_v<Opts...>>());
+        }
+        else
+        {
+            return lower<ie, lowering_v<Opts...>>();
+        }
+    }
+
+    template <auto const& ie, typename... Opts>
+    constexpr inline auto program_v = make_program<ie, Opts...>();
+
+    // Concatenate the terms of several tables so that a single program evaluates all of them
+    template <typename A, width_t... I, width_t... M, width_t... T>
+    [[nodiscard]] constexpr auto fuse(mv<A, I, M, T> const&... in) noexcept
+    {
+        mv<A, (I + ... + 0), (M + ... + 0), (T + ... + 0)> out{};
+        auto append = [&out](auto const& table) {
+            for (auto it = table.cbegin(); it != table.cend(); ++it)
+            {
+                out.push(it, one, it->element);
+            }
+        };
+        (append(in), ...);
+        return out;
+    }
+
+    // A table partially evaluated for the indeterminates marked as bound (see `split`)
+    template <typename A, width_t I, width_t M, width_t T>
+    struct split_table
+    {
+        // One term per coefficient, each summing the bound parts of a group of monomials
+        mv<A, I, M, M> coefficients;
+        // The original terms over the free indeterminates, with coefficient k read as indeterminate `base + k`
+        mv<A, I + M, M, T> free;
+    };
+
+    // Split every monomial q*b*f of the table into the factors b of bound indeterminates and the factors f of free
+    // ones. Monomials of a term sharing the same free factors are grouped, and the sum of their bound parts becomes a
+    // coefficient which can be evaluated once for all values of the free indeterminates. Each group leaves a single
+    // monomial f times its coefficient in the free table. Groups without bound factors keep their rational coefficient
+    // instead.
+    template <typename A, width_t I, width_t M, width_t T, size_t N>
+    [[nodiscard]] constexpr auto
+    split(mv<A, I, M, T> const& ie, std::array<bool, N> const& bound, width_t base) noexcept
+    {
+        split_table<A, I, M, T> out{};
+        auto is_bound = [&bound](ind const& f) { return f.id < N && bound[f.id]; };
+
+        // Whether two monomials have the same free factors (indeterminates are sorted within monomials)
+        auto same_free = [&ie, &is_bound](mon const& lhs, mon const& rhs) {
+            width_t i = lhs.ind_offset;
+            width_t j = rhs.ind_offset;
+            while (true)
+            {
+                while (i != lhs.ind_offset + lhs.count && is_bound(ie.inds[i]))
+                {
+                    ++i;
+                }
+                while (j != rhs.ind_offset + rhs.count && is_bound(ie.inds[j]))
+                {
+                    ++j;
+                }
+                if (i == lhs.ind_offset + lhs.count || j == rhs.ind_offset + rhs.count)
+                {
+                    return i == lhs.ind_offset + lhs.count && j == rhs.ind_offset + rhs.count;
+                }
+                if (ie.inds[i] != ie.inds[j])
+                {
+                    return false;
+                }
+                ++i;
+                ++j;
+            }
+        };
+
+        auto& coefficients = out.coefficients;
+        auto& free         = out.free;
+        std::array<bool, M == 0 ? 1 : M> grouped{};
+        for (width_t t = 0; t != ie.size.term; ++t)
+        {
+            auto const& in = ie.terms[t];
+            auto& out_term = free.terms[free.size.term++];
+            out_term       = term{0, free.size.mon, in.element};
+
+            for (width_t m = in.mon_offset; m != in.mon_offset + in.count; ++m)
+            {
+                if (grouped[m] || ie.mons[m].q.is_zero())
+                {
+                    continue;
+                }
+
+                // Gather the group led by monomial m
+                auto& coefficient = coefficients.terms[coefficients.size.term];
+                coefficient       = term{0, coefficients.size.mon, 0};
+                bool has_bound    = false;
+                rat q             = zero;
+                for (width_t n = m; n != in.mon_offset + in.count; ++n)
+                {
+                    auto const& factors = ie.mons[n];
+                    if (grouped[n] || factors.q.is_zero() || !same_free(ie.mons[m], factors))
+                    {
+                        continue;
+                    }
+                    grouped[n] = true;
+                    q          = q + factors.q;
+
+                    mon bound_part{factors.q, zero, 0, coefficients.size.ind};
+                    for (width_t i = factors.ind_offset; i != factors.ind_offset + factors.count; ++i)
+                    {
+                        if (is_bound(ie.inds[i]))
+                        {
+                            coefficients.inds[coefficients.size.ind++] = ie.inds[i];
+                            bound_part.degree += ie.inds[i].degree;
+                            ++bound_part.count;
+                        }
+                    }
+                    has_bound = has_bound || bound_part.count != 0;
+                    coefficients.mons[coefficients.size.mon++] = bound_part;
+                    ++coefficient.count;
+                }
+
+                if (has_bound)
+                {
+                    ++coefficients.size.term;
+                }
+                else
+                {
+                    // The group is a constant multiple of its free factors
+                    coefficients.size.mon -= coefficient.count;
+                    if (q.is_zero())
+                    {
+                        continue;
+                    }
+                }
+
+                auto const& leader = ie.mons[m];
+                mon free_part{has_bound ? one : q, zero, 0, free.size.ind};
+                for (width_t i = leader.ind_offset; i != leader.ind_offset + leader.count; ++i)
+                {
+                    if (!is_bound(ie.inds[i]))
+                    {
+                        free.inds[free.size.ind++] = ie.inds[i];
+                        free_part.degree += ie.inds[i].degree;
+                        ++free_part.count;
+                    }
+                }
+                if (has_bound)
+                {
+                    // Coefficients follow every other indeterminate, so the factors of the monomial stay sorted
+                    free.inds[free.size.ind++] = ind{base + coefficients.size.term - 1, one};
+                    free_part.degree += one;
+                    ++free_part.count;
+                }
+                free.mons[free.size.mon++] = free_part;
+                ++out_term.count;
+            }
+        }
+        return out;
+    }
+
+    // Instructions are dispatched on their opcode alone. Operands are read from the program which, being a constant
+    // expression, lets the optimizer fold them once inlined. This keeps the number of template instantiations
+    // independent of the program length.
+    template <instr_op Op, typename F, typename D>
+    [[nodiscard]] constexpr F step(F const* slots, D const& data, instr const& in) noexcept
+    {
+        if constexpr (Op == instr_op::load)
+        {
+            return load(data, in.a);
+        }
+        else if constexpr (Op == instr_op::pow)
+        {
+            return ::gal::pow(load(data, in.a), in.q.num, in.q.den);
+        }
+        else if constexpr (Op == instr_op::mul)
+        {
+            return slots[in.a] * slots[in.b];
+        }
+        else if constexpr (Op == instr_op::add)
+        {
+            return slots[in.a] + slots[in.b];
+        }
+        else if constexpr (Op == instr_op::sub)
+        {
+            return slots[in.a] - slots[in.b];
+        }
+        else if constexpr (Op == instr_op::scale)
+        {
+            return static_cast<F>(in.q) * slots[in.a];
+        }
+        else if constexpr (Op == instr_op::fma)
+        {
+            using std::fma;
+            return fma(slots[in.a], slots[in.b], slots[in.c]);
+        }
+        else if constexpr (Op == instr_op::fms)
+        {
+            using std::fma;
+            return fma(slots[in.a], slots[in.b], -slots[in.c]);
+        }
+        else if constexpr (Op == instr_op::fnma)
+        {
+            using std::fma;
+            return fma(-slots[in.a], slots[in.b], slots[in.c]);
+        }
+        else
+        {
+            return static_cast<F>(in.q);
+        }
+    }
+
+    // Run every instruction of the program in order, writing slot I with the result of instruction I
+    template <auto const& p, typename F, typename D, size_t... I>
+    constexpr void execute(F* slots, D const& data, std::index_sequence<I...>) noexcept
+    {
+        ((slots[I] = step<p.instrs[I].op>(slots, data, p.instrs[I])), ...);
+    }
+} // namespace detail
+} // namespace gal
@@ -0,0 +1,582 @@
+#pragma once
+
+#include "numeric.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#    include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h>
+#endif
+
+// A value type packing N independent lanes which can be substituted anywhere GAL expects a scalar field type. For
+// example, computing with `pga::point<simd<float, 8>>` evaluates 8 independent geometries with each instruction.
+//
+// The packed representation is selected at compile time from the instruction sets enabled for the translation unit
+// (e.g. via -msse2, -mavx2 -mfma, or -mavx512f). Widths without a matching instruction set fall back to a plain array
+// of lanes which compilers readily auto-vectorize. Because the layout of `simd` depends on compiler flags, the
+// definitions live in an inline namespace named after the instruction set. Translation units compiled with different
+// flags can then be linked together without violating the ODR, and `gal::dispatch` can select between kernels built in
+// each of them at runtime.
+
+#if defined(__AVX512F__)
+#    define GAL_SIMD_ABI simd_avx512
+#elif defined(__AVX2__)
+#    define GAL_SIMD_ABI simd_avx2
+#elif defined(__SSE2__)
+#    define GAL_SIMD_ABI simd_sse2
+#else
+#    define GAL_SIMD_ABI simd_scalar
+#endif
+
+namespace gal
+{
+// Instruction sets ordered from narrowest to widest
+enum class simd_isa
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512,
+};
+
+// The widest instruction set GAL uses in this translation unit
+constexpr inline simd_isa native_isa =
+#if defined(__AVX512F__)
+    simd_isa::avx512;
+#elif defined(__AVX2__)
+    simd_isa::avx2;
+#elif defined(__SSE2__)
+    simd_isa::sse2;
+#else
+    simd_isa::scalar;
+#endif
+
+// The widest instruction set supported by the processor the program is running on. As for `native_isa`, AVX2 does not
+// imply FMA; the AVX2 implementation only fuses multiply-adds where FMA is also enabled.
+[[nodiscard]] inline simd_isa host_isa() noexcept
+{
+#if (defined(__clang__) || defined(__GNUG__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return simd_isa::avx512;
+    }
+    else if (__builtin_cpu_supports("avx2"))
+    {
+        return simd_isa::avx2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+        return simd_isa::sse2;
+    }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    // Without the builtins, read the feature bits with cpuid. The wide registers are only usable if the OS saves them on
+    // context switches, which it reports in XCR0 (bits 1-2 for the YMM state, 5-7 for the AVX-512 state).
+    int info[4];
+    __cpuid(info, 0);
+    int const max_leaf = info[0];
+    __cpuid(info, 1);
+    bool const sse2               = (info[3] & (1 << 26)) != 0;
+    bool const avx                = (info[2] & (1 << 28)) != 0;
+    bool const osxsave            = (info[2] & (1 << 27)) != 0;
+    unsigned long long const xcr0 = osxsave ? _xgetbv(0) : 0;
+    if (max_leaf >= 7 && avx && (xcr0 & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6)
+        {
+            return simd_isa::avx512;
+        }
+        else if ((info[1] & (1 << 5)) != 0)
+        {
+            return simd_isa::avx2;
+        }
+    }
+    if (sse2)
+    {
+        return simd_isa::sse2;
+    }
+#endif
+    return simd_isa::scalar;
+}
+
+// Given one candidate per instruction set (indexed by `simd_isa`, null if unavailable), return the candidate for the
+// widest instruction set supported by the host. Candidates are typically the same kernel instantiated in translation
+// units compiled for each instruction set.
+template <typename F>
+[[nodiscard]] F dispatch(std::array<F, 4> const& candidates) noexcept
+{
+    for (size_t i = static_cast<size_t>(host_isa()) + 1; i-- > 0;)
+    {
+        if (candidates[i])
+        {
+            return candidates[i];
+        }
+    }
+    return nullptr;
+}
+
+inline namespace GAL_SIMD_ABI
+{
+    // Generic implementation storing lanes in an array. Every operation is a simple loop over lanes.
+    template <typename T, size_t N>
+    struct simd
+    {
+        using value_t = T;
+
+        std::array<T, N> lanes;
+
+        [[nodiscard]] constexpr static size_t size() noexcept
+        {
+            return N;
+        }
+
+        simd() = default;
+
+        constexpr simd(T s) noexcept
+            : lanes{}
+        {
+            for (size_t i = 0; i != N; ++i)
+            {
+                lanes[i] = s;
+            }
+        }
+
+        constexpr explicit simd(rat q) noexcept
+            : simd{static_cast<T>(q)}
+        {}
+
+        [[nodiscard]] static simd load(T const* in) noexcept
+        {
+            simd out;
+            for (size_t i = 0; i != N; ++i)
+            {
+                out.lanes[i] = in[i];
+            }
+            return out;
+        }
+
+        void store(T* out) const noexcept
+        {
+            for (size_t i = 0; i != N; ++i)
+            {
+                out[i] = lanes[i];
+            }
+        }
+
+        [[nodiscard]] constexpr T operator[](size_t i) const noexcept
+        {
+            return lanes[i];
+        }
+
+        template <typename Op>
+        [[nodiscard]] constexpr simd map(simd const& other, Op&& op) const noexcept
+        {
+            simd out;
+            for (size_t i = 0; i != N; ++i)
+            {
+                out.lanes[i] = op(lanes[i], other.lanes[i]);
+            }
+            return out;
+        }
+
+        constexpr simd& operator+=(simd const& other) noexcept
+        {
+            return *this = map(other, [](T a, T b) { return a + b; });
+        }
+
+        constexpr simd& operator-=(simd const& other) noexcept
+        {
+            return *this = map(other, [](T a, T b) { return a - b; });
+        }
+
+        constexpr simd& operator*=(simd const& other) noexcept
+        {
+            return *this = map(other, [](T a, T b) { return a * b; });
+        }
+
+        constexpr simd& operator/=(simd const& other) noexcept
+        {
+            return *this = map(other, [](T a, T b) { return a / b; });
+        }
+
+        [[nodiscard]] constexpr simd operator-() const noexcept
+        {
+            return map(*this, [](T a, T) { return -a; });
+        }
+
+        [[nodiscard]] friend simd sqrt(simd const& in) noexcept
+        {
+            return in.map(in, [](T a, T) { return std::sqrt(a); });
+        }
+
+        [[nodiscard]] friend simd pow(simd const& base, simd const& exponent) noexcept
+        {
+            return base.map(exponent, [](T a, T b) { return std::pow(a, b); });
+        }
+
+        [[nodiscard]] friend simd fma(simd const& a, simd const& b, simd const& c) noexcept
+        {
+            simd out;
+            for (size_t i = 0; i != N; ++i)
+            {
+                out.lanes[i] = std::fma(a.lanes[i], b.lanes[i], c.lanes[i]);
+            }
+            return out;
+        }
+    };
+
+#if defined(__SSE2__)
+    template <>
+    struct simd<float, 4>
+    {
+        using value_t = float;
+
+        __m128 v;
+
+        [[nodiscard]] constexpr static size_t size() noexcept
+        {
+            return 4;
+        }
+
+        simd() = default;
+
+        simd(__m128 in) noexcept
+            : v{in}
+        {}
+
+        simd(float s) noexcept
+            : v{_mm_set1_ps(s)}
+        {}
+
+        explicit simd(rat q) noexcept
+            : v{_mm_set1_ps(static_cast<float>(q))}
+        {}
+
+        [[nodiscard]] static simd load(float const* in) noexcept
+        {
+            return _mm_loadu_ps(in);
+        }
+
+        void store(float* out) const noexcept
+        {
+            _mm_storeu_ps(out, v);
+        }
+
+        [[nodiscard]] float operator[](size_t i) const noexcept
+        {
+            alignas(16) float out[4];
+            _mm_store_ps(out, v);
+            return out[i];
+        }
+
+        simd& operator+=(simd other) noexcept
+        {
+            v = _mm_add_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator-=(simd other) noexcept
+        {
+            v = _mm_sub_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator*=(simd other) noexcept
+        {
+            v = _mm_mul_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator/=(simd other) noexcept
+        {
+            v = _mm_div_ps(v, other.v);
+            return *this;
+        }
+
+        [[nodiscard]] simd operator-() const noexcept
+        {
+            return _mm_xor_ps(v, _mm_set1_ps(-0.f));
+        }
+
+        [[nodiscard]] friend simd sqrt(simd in) noexcept
+        {
+            return _mm_sqrt_ps(in.v);
+        }
+
+        [[nodiscard]] friend simd pow(simd base, simd exponent) noexcept
+        {
+            alignas(16) float b[4];
+            alignas(16) float e[4];
+            _mm_store_ps(b, base.v);
+            _mm_store_ps(e, exponent.v);
+            return _mm_setr_ps(std::pow(b[0], e[0]), std::pow(b[1], e[1]), std::pow(b[2], e[2]), std::pow(b[3], e[3]));
+        }
+
+        [[nodiscard]] friend simd fma(simd a, simd b, simd c) noexcept
+        {
+#    if defined(__FMA__)
+            return _mm_fmadd_ps(a.v, b.v, c.v);
+#    else
+            return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v);
+#    endif
+        }
+    };
+#endif
+
+#if defined(__AVX2__)
+    template <>
+    struct simd<float, 8>
+    {
+        using value_t = float;
+
+        __m256 v;
+
+        [[nodiscard]] constexpr static size_t size() noexcept
+        {
+            return 8;
+        }
+
+        simd() = default;
+
+        simd(__m256 in) noexcept
+            : v{in}
+        {}
+
+        simd(float s) noexcept
+            : v{_mm256_set1_ps(s)}
+        {}
+
+        explicit simd(rat q) noexcept
+            : v{_mm256_set1_ps(static_cast<float>(q))}
+        {}
+
+        [[nodiscard]] static simd load(float const* in) noexcept
+        {
+            return _mm256_loadu_ps(in);
+        }
+
+        void store(float* out) const noexcept
+        {
+            _mm256_storeu_ps(out, v);
+        }
+
+        [[nodiscard]] float operator[](size_t i) const noexcept
+        {
+            alignas(32) float out[8];
+            _mm256_store_ps(out, v);
+            return out[i];
+        }
+
+        simd& operator+=(simd other) noexcept
+        {
+            v = _mm256_add_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator-=(simd other) noexcept
+        {
+            v = _mm256_sub_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator*=(simd other) noexcept
+        {
+            v = _mm256_mul_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator/=(simd other) noexcept
+        {
+            v = _mm256_div_ps(v, other.v);
+            return *this;
+        }
+
+        [[nodiscard]] simd operator-() const noexcept
+        {
+            return _mm256_xor_ps(v, _mm256_set1_ps(-0.f));
+        }
+
+        [[nodiscard]] friend simd sqrt(simd in) noexcept
+        {
+            return _mm256_sqrt_ps(in.v);
+        }
+
+        [[nodiscard]] friend simd pow(simd base, simd exponent) noexcept
+        {
+            alignas(32) float b[8];
+            alignas(32) float e[8];
+            _mm256_store_ps(b, base.v);
+            _mm256_store_ps(e, exponent.v);
+            for (size_t i = 0; i != 8; ++i)
+            {
+                b[i] = std::pow(b[i], e[i]);
+            }
+            return _mm256_load_ps(b);
+        }
+
+        [[nodiscard]] friend simd fma(simd a, simd b, simd c) noexcept
+        {
+#    if defined(__FMA__)
+            return _mm256_fmadd_ps(a.v, b.v, c.v);
+#    else
+            return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+#    endif
+        }
+    };
+#endif
+
+#if defined(__AVX512F__)
+    template <>
+    struct simd<float, 16>
+    {
+        using value_t = float;
+
+        __m512 v;
+
+        [[nodiscard]] constexpr static size_t size() noexcept
+        {
+            return 16;
+        }
+
+        simd() = default;
+
+        simd(__m512 in) noexcept
+            : v{in}
+        {}
+
+        simd(float s) noexcept
+            : v{_mm512_set1_ps(s)}
+        {}
+
+        explicit simd(rat q) noexcept
+            : v{_mm512_set1_ps(static_cast<float>(q))}
+        {}
+
+        [[nodiscard]] static simd load(float const* in) noexcept
+        {
+            return _mm512_loadu_ps(in);
+        }
+
+        void store(float* out) const noexcept
+        {
+            _mm512_storeu_ps(out, v);
+        }
+
+        [[nodiscard]] float operator[](size_t i) const noexcept
+        {
+            alignas(64) float out[16];
+            _mm512_store_ps(out, v);
+            return out[i];
+        }
+
+        simd& operator+=(simd other) noexcept
+        {
+            v = _mm512_add_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator-=(simd other) noexcept
+        {
+            v = _mm512_sub_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator*=(simd other) noexcept
+        {
+            v = _mm512_mul_ps(v, other.v);
+            return *this;
+        }
+
+        simd& operator/=(simd other) noexcept
+        {
+            v = _mm512_div_ps(v, other.v);
+            return *this;
+        }
+
+        [[nodiscard]] simd operator-() const noexcept
+        {
+            return _mm512_sub_ps(_mm512_setzero_ps(), v);
+        }
+
+        [[nodiscard]] friend simd sqrt(simd in) noexcept
+        {
+            return _mm512_sqrt_ps(in.v);
+        }
+
+        [[nodiscard]] friend simd pow(simd base, simd exponent) noexcept
+        {
+            alignas(64) float b[16];
+            alignas(64) float e[16];
+            _mm512_store_ps(b, base.v);
+            _mm512_store_ps(e, exponent.v);
+            for (size_t i = 0; i != 16; ++i)
+            {
+                b[i] = std::pow(b[i], e[i]);
+            }
+            return _mm512_load_ps(b);
+        }
+
+        [[nodiscard]] friend simd fma(simd a, simd b, simd c) noexcept
+        {
+            return _mm512_fmadd_ps(a.v, b.v, c.v);
+        }
+    };
+#endif
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator+(simd<T, N> lhs, simd<T, N> const& rhs) noexcept
+    {
+        return lhs += rhs;
+    }
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator-(simd<T, N> lhs, simd<T, N> const& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator*(simd<T, N> lhs, simd<T, N> const& rhs) noexcept
+    {
+        return lhs *= rhs;
+    }
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator/(simd<T, N> lhs, simd<T, N> const& rhs) noexcept
+    {
+        return lhs /= rhs;
+    }
+
+    // Mixed scalar and packed arithmetic broadcasts the scalar
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator*(T lhs, simd<T, N> const& rhs) noexcept
+    {
+        return simd<T, N>{lhs} * rhs;
+    }
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator*(simd<T, N> const& lhs, T rhs) noexcept
+    {
+        return lhs * simd<T, N>{rhs};
+    }
+
+    template <typename T, size_t N>
+    [[nodiscard]] simd<T, N> operator/(T lhs, simd<T, N> const& rhs) noexcept
+    {
+        return simd<T, N>{lhs} / rhs;
+    }
+} // namespace GAL_SIMD_ABI
+
+// The number of float lanes packed by the widest instruction set enabled in this translation unit
+constexpr inline size_t native_width = native_isa == simd_isa::avx512 ? 16
+                                       : native_isa == simd_isa::avx2 ? 8
+                                       : native_isa == simd_isa::sse2 ? 4
+                                                                      : 1;
+} // namespace gal
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "entity.hpp"
+
+#include <tuple>
+#include <type_traits>
+
+// Staging of non-polynomial nodes (`sqrt`, `inv`, `sin`, `cos`, `exp`, `atan2` and literals). Expressions handed to the
+// engine are rewritten so that every distinct non-polynomial node is replaced by a fresh scalar indeterminate. The nodes
+// themselves (with their operands rewritten in the same way) are collected as stages in dependency order. The engine
+// evaluates each stage into its temporary before running the polynomial kernel, all within a single call.
+
+namespace gal
+{
+namespace detail
+{
+    template <expr_op O>
+    constexpr inline bool is_staged_v = !(O < expr_op::sqrt);
+
+    // Index of T within the tuple of stages, or the number of stages if absent
+    template <typename T, typename Stages>
+    struct stage_index;
+
+    template <typename T, typename... S>
+    struct stage_index<T, std::tuple<S...>>
+    {
+        constexpr static uint32_t value = [] {
+            constexpr bool found[] = {std::is_same_v<T, S>..., true};
+            uint32_t i             = 0;
+            while (!found[i])
+            {
+                ++i;
+            }
+            return i;
+        }();
+    };
+
+    template <typename T, typename Stages>
+    struct stage_append;
+
+    template <typename T, typename... S>
+    struct stage_append<T, std::tuple<S...>>
+    {
+        using type = std::conditional_t<stage_index<T, std::tuple<S...>>::value == sizeof...(S),
+                                        std::tuple<S..., T>,
+                                        std::tuple<S...>>;
+    };
+
+    // Rewrite the expression T given the stages collected so far. Temporaries are numbered starting at Base. Types
+    // which are not expressions (entities, constants, element lists) are left untouched.
+    template <typename T, uint32_t Base, typename Stages>
+    struct stage_rewrite
+    {
+        using type   = T;
+        using stages = Stages;
+    };
+
+    template <expr_op O, typename T1, typename T2, uint32_t Base, typename Stages, bool = is_staged_v<O>>
+    struct stage_node
+    {
+        using type   = expr<O, T1, T2>;
+        using stages = Stages;
+    };
+
+    template <expr_op O, typename T1, typename T2, uint32_t Base, typename Stages>
+    struct stage_node<O, T1, T2, Base, Stages, true>
+    {
+        using stages = typename stage_append<expr<O, T1, T2>, Stages>::type;
+        using type   = expr<expr_op::identity,
+                          scalar<typename T1::algebra_t, typename T1::value_t>,
+                          std::integral_constant<uint32_t, Base + stage_index<expr<O, T1, T2>, stages>::value>>;
+    };
+
+    template <expr_op O, typename T1, typename T2, uint32_t Base, typename Stages>
+    struct stage_rewrite<expr<O, T1, T2>, Base, Stages>
+    {
+        using lhs    = stage_rewrite<T1, Base, Stages>;
+        using rhs    = stage_rewrite<T2, Base, typename lhs::stages>;
+        using node   = stage_node<O, typename lhs::type, typename rhs::type, Base, typename rhs::stages>;
+        using type   = typename node::type;
+        using stages = typename node::stages;
+    };
+
+    // Lambdas returning multiple results share their stages
+    template <uint32_t Base, typename Stages>
+    struct stage_rewrite<std::tuple<>, Base, Stages>
+    {
+        using type   = std::tuple<>;
+        using stages = Stages;
+    };
+
+    template <typename T, typename... Ts, uint32_t Base, typename Stages>
+    struct stage_rewrite<std::tuple<T, Ts...>, Base, Stages>
+    {
+        using first  = stage_rewrite<T, Base, Stages>;
+        using rest   = stage_rewrite<std::tuple<Ts...>, Base, typename first::stages>;
+        using type   = decltype(std::tuple_cat(std::declval<std::tuple<typename first::type>>(),
+                                             std::declval<typename rest::type>()));
+        using stages = typename rest::stages;
+    };
+
+    // The polynomial expression (or tuple of expressions) T evaluates to once its non-polynomial nodes are staged into
+    // temporaries following the Base indeterminates of the inputs
+    template <typename T, uint32_t Base>
+    struct staged
+    {
+        using rewrite = stage_rewrite<T, Base, std::tuple<>>;
+        using type    = typename rewrite::type;
+        using stages  = typename rewrite::stages;
+
+        constexpr static uint32_t base  = Base;
+        constexpr static uint32_t count = std::tuple_size_v<stages>;
+    };
+} // namespace detail
+} // namespace gal
@@ -3,6 +3,7 @@
 #include <doctest/doctest.h>
 #include <fmt/core.h>
 #include <gal/engine.hpp>
+#include <gal/geometric_algebra.hpp>
 
 using namespace gal;
 
@@ -264,4 +265,74 @@ TEST_CASE("polynomial-expansion")
     }
 }
 
+// Whether the Cayley table of the product P agrees with its definition in terms of the generators for all pairs of
+// basis elements
+template <typename A, typename P>
+constexpr bool matches_definition()
+{
+    constexpr size_t n = size_t{1} << A::metric_t::dimension;
+    for (size_t lhs = 0; lhs != n; ++lhs)
+    {
+        for (size_t rhs = 0; rhs != n; ++rhs)
+        {
+            auto [element, sign]             = P::product(lhs, rhs);
+            auto [blade_element, blade_sign] = P::blade_product(lhs, rhs);
+            if (sign != blade_sign || (sign != 0 && element != blade_element))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename A>
+constexpr bool tables_match_definition()
+{
+    return matches_definition<A, typename A::geometric>() && matches_definition<A, typename A::exterior>()
+           && matches_definition<A, typename A::contract>() && matches_definition<A, typename A::symmetric_inner>();
+}
+
+TEST_CASE("cayley-tables")
+{
+    static_assert(tables_match_definition<algebra<metric<3, 0, 0>>>());
+    static_assert(tables_match_definition<algebra<metric<3, 0, 1>>>());
+    static_assert(tables_match_definition<algebra<metric<3, 1, 0>>>());
+    static_assert(tables_match_definition<algebra<metric<4, 1, 0>>>());
+
+    // Checked at runtime; comparing all 2^16 pairs of basis elements exceeds the constant evaluation limits
+    CHECK(tables_match_definition<algebra<metric<7, 1, 0>>>());
+}
+
+TEST_CASE("wide-blade-ids")
+{
+    // The double conformal algebra of quadric surfaces has ten generators
+    using dcga_algebra = algebra<metric<8, 2, 0>>;
+    static_assert(std::is_same_v<algebra<metric<3, 0, 1>>::blade_t, uint8_t>);
+    static_assert(std::is_same_v<dcga_algebra::blade_t, uint16_t>);
+    static_assert(std::is_same_v<algebra<metric<3, 0, 1>, uint32_t>::blade_t, uint32_t>);
+
+    static_assert(dcga_algebra::geometric::product(0b1000000000, 0b1000000000).second == -1);
+    static_assert(dcga_algebra::geometric::product(0b1000000000, 0b1).first == 0b1000000001);
+    static_assert(dcga_algebra::geometric::product(0b1000000000, 0b1).second == -1);
+    static_assert(dcga_algebra::exterior::product(0b1100000000, 0b1000000000).second == 0);
+
+    SUBCASE("geometric-product-of-vectors")
+    {
+        using vector_t = entity<dcga_algebra, double, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512>;
+        vector_t u{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        vector_t v{2, -1, 0, 1, 3, -2, 1, 0, 4, -3};
+        auto const uv = compute([](auto u, auto v) { return u * v; }, u, v);
+
+        double dot = 0;
+        for (size_t i = 0; i != 10; ++i)
+        {
+            dot += (i < 8 ? 1 : -1) * u[i] * v[i];
+        }
+        CHECK_EQ(uv.select(0), doctest::Approx(dot));
+        CHECK_EQ(uv.select(0b1000000001), doctest::Approx(u[0] * v[9] - u[9] * v[0]));
+        CHECK_EQ(uv.select(0b0000100100), doctest::Approx(u[2] * v[5] - u[5] * v[2]));
+    }
+}
+
 TEST_SUITE_END();
\ No newline at end of file
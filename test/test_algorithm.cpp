@@ -1,6 +1,11 @@
 #include <gal/algorithm.hpp>
 #include <doctest/doctest.h>
 
+#include <utility>
+
+using gal::detail::counting_sort;
+using gal::detail::heap_sort;
+using gal::detail::merge_sort;
 using gal::detail::sort;
 
 TEST_SUITE_BEGIN("algorithm");
@@ -121,4 +126,109 @@ TEST_CASE("sort")
     }
 }
 
+TEST_CASE("heap-sort")
+{
+    auto less = [](int lhs, int rhs) { return lhs < rhs; };
+
+    SUBCASE("empty")
+    {
+        std::array<int, 0> a = {};
+        heap_sort(a.begin(), a.end(), less);
+    }
+
+    SUBCASE("presorted")
+    {
+        std::array<int, 6> a = {1, 2, 3, 4, 5, 6};
+        heap_sort(a.begin(), a.end(), less);
+
+        for (int i = 0; i != 6; ++i)
+        {
+            CHECK_EQ(a[i], i + 1);
+        }
+    }
+
+    SUBCASE("duplicates")
+    {
+        std::array<int, 9> a = {3, 1, 2, 3, 1, 9, 2, 7, 1};
+        heap_sort(a.begin(), a.end(), less);
+
+        std::array<int, 9> expected = {1, 1, 1, 2, 2, 3, 3, 7, 9};
+        for (size_t i = 0; i != 9; ++i)
+        {
+            CHECK_EQ(a[i], expected[i]);
+        }
+    }
+}
+
+TEST_CASE("merge-sort")
+{
+    // Sorted by the first member only to check that equivalent elements keep their order
+    auto less = [](std::pair<int, int> lhs, std::pair<int, int> rhs) { return lhs.first < rhs.first; };
+
+    SUBCASE("presorted")
+    {
+        std::array<std::pair<int, int>, 12> a{};
+        for (int i = 0; i != 12; ++i)
+        {
+            a[i] = {i, 0};
+        }
+        std::array<std::pair<int, int>, 6> buffer{};
+        merge_sort(a.begin(), a.end(), buffer.begin(), less);
+
+        for (int i = 0; i != 12; ++i)
+        {
+            CHECK_EQ(a[i].first, i);
+        }
+    }
+
+    SUBCASE("stable")
+    {
+        std::array<std::pair<int, int>, 13> a = {{{5, 0}, {2, 1}, {9, 2}, {2, 3}, {7, 4}, {5, 5}, {0, 6},
+                                                  {9, 7}, {2, 8}, {1, 9}, {5, 10}, {0, 11}, {7, 12}}};
+        std::array<std::pair<int, int>, 6> buffer{};
+        merge_sort(a.begin(), a.end(), buffer.begin(), less);
+
+        std::array<std::pair<int, int>, 13> expected = {{{0, 6}, {0, 11}, {1, 9}, {2, 1}, {2, 3}, {2, 8}, {5, 0},
+                                                         {5, 5}, {5, 10}, {7, 4}, {7, 12}, {9, 2}, {9, 7}}};
+        for (size_t i = 0; i != 13; ++i)
+        {
+            CHECK_EQ(a[i], expected[i]);
+        }
+    }
+}
+
+TEST_CASE("counting-sort")
+{
+    auto key = [](int value) { return value; };
+
+    SUBCASE("empty")
+    {
+        std::array<int, 0> a = {};
+        counting_sort<4>(a.begin(), a.end(), key);
+    }
+
+    SUBCASE("duplicates")
+    {
+        std::array<int, 12> a = {3, 1, 2, 3, 1, 0, 2, 7, 1, 7, 0, 3};
+        counting_sort<8>(a.begin(), a.end(), key);
+
+        std::array<int, 12> expected = {0, 0, 1, 1, 1, 2, 2, 3, 3, 3, 7, 7};
+        for (size_t i = 0; i != 12; ++i)
+        {
+            CHECK_EQ(a[i], expected[i]);
+        }
+    }
+
+    SUBCASE("reversed")
+    {
+        std::array<int, 8> a = {7, 6, 5, 4, 3, 2, 1, 0};
+        counting_sort<8>(a.begin(), a.end(), key);
+
+        for (int i = 0; i != 8; ++i)
+        {
+            CHECK_EQ(a[i], i);
+        }
+    }
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/approx.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace gal;
+
+TEST_SUITE_BEGIN("approx");
+
+// The distance between the approximation and the exact result in units of the last place of the exact result
+template <typename T>
+double ulp_error(T value, long double exact)
+{
+    T rounded = static_cast<T>(std::abs(exact));
+    T ulp     = std::nextafter(rounded, std::numeric_limits<T>::infinity()) - rounded;
+    return static_cast<double>(std::abs(static_cast<long double>(value) - exact) / ulp);
+}
+
+template <typename T>
+void check_bounds(double sincos_bound, double atan2_bound)
+{
+    constexpr int samples = 200000;
+
+    double sin_error   = 0;
+    double cos_error   = 0;
+    double atan2_error = 0;
+    double sqrt_error  = 0;
+    for (int i = 0; i != samples; ++i)
+    {
+        // Arguments spread over [-2^20, 2^20] with a dense sampling of the first few periods
+        auto u = static_cast<long double>(i) / samples;
+        auto x = static_cast<T>((i % 2 == 0 ? 20 : std::ldexp(1.0L, 20)) * (2 * u - 1) + 0.001L * i);
+
+        T s;
+        T c;
+        approx::sincos(x, s, c);
+        sin_error = std::max(sin_error, ulp_error(s, std::sin(static_cast<long double>(x))));
+        cos_error = std::max(cos_error, ulp_error(c, std::cos(static_cast<long double>(x))));
+
+        // Points around the unit circle at magnitudes from 1e-3 to 1e3
+        auto angle     = 6.2831853071795864769L * u * 97;
+        auto magnitude = std::pow(10.0L, static_cast<long double>(i % 7) - 3);
+        auto py        = static_cast<T>(magnitude * std::sin(angle));
+        auto px        = static_cast<T>(std::cos(angle * 3));
+        atan2_error    = std::max(atan2_error,
+                               ulp_error(approx::atan2(py, px),
+                                         std::atan2(static_cast<long double>(py), static_cast<long double>(px))));
+
+        auto q     = static_cast<T>(std::exp(80 * u - 40));
+        sqrt_error = std::max(sqrt_error, ulp_error(approx::sqrt(q), std::sqrt(static_cast<long double>(q))));
+    }
+
+    CHECK_LE(sin_error, sincos_bound);
+    CHECK_LE(cos_error, sincos_bound);
+    CHECK_LE(atan2_error, atan2_bound);
+    CHECK_LE(sqrt_error, 1.0);
+}
+
+TEST_CASE("ulp-bounds")
+{
+    // The bounds documented in approx.hpp
+    SUBCASE("float")
+    {
+        check_bounds<float>(1.6, 2.5);
+    }
+
+    SUBCASE("double")
+    {
+        check_bounds<double>(1.6, 1.6);
+    }
+}
+
+TEST_CASE("special-values")
+{
+    CHECK_EQ(approx::sin(0.0), 0.0);
+    CHECK_EQ(approx::cos(0.0), 1.0);
+    CHECK_EQ(approx::sqrt(0.f), 0.f);
+    CHECK_EQ(approx::sqrt(4.0), 2.0);
+
+    // atan2 covers all four quadrants and the axes
+    CHECK_EQ(approx::atan2(0.0, 1.0), 0.0);
+    CHECK_EQ(approx::atan2(0.0, 0.0), 0.0);
+    CHECK_EQ(approx::atan2(1.0, 0.0), doctest::Approx(std::atan2(1.0, 0.0)));
+    CHECK_EQ(approx::atan2(0.0, -1.0), doctest::Approx(std::atan2(0.0, -1.0)));
+    CHECK_EQ(approx::atan2(-0.0, -1.0), doctest::Approx(std::atan2(-0.0, -1.0)));
+    CHECK_EQ(approx::atan2(-1.f, -1.f), doctest::Approx(std::atan2(-1.f, -1.f)));
+    CHECK_EQ(approx::atan2(2.f, -1.f), doctest::Approx(std::atan2(2.f, -1.f)));
+}
+
+TEST_SUITE_END();
@@ -27,4 +27,52 @@ TEST_CASE("point-norm")
     CHECK_EQ(p_norm.size(), 0);
 }
 
+TEST_CASE("versor-exp-log")
+{
+    point<double> t{1.5, -2, 0.25};
+    point<double> axis{0, 0, 1};
+
+    SUBCASE("translator")
+    {
+        // Translation generators square to zero so the exponential is exactly 1 + B
+        auto b  = compute([](auto t) { return frac<-1, 2> * extract<0b1, 0b10, 0b100>{}(t) ^ n_i<double>; }, t);
+        auto const tr = compute([](auto b) { return versor_exp(b); }, b);
+        CHECK_EQ(tr[0], doctest::Approx(1));
+        for (size_t i = 0; i != b.size(); ++i)
+        {
+            CHECK_EQ(tr.select(b.elements[i]), doctest::Approx(b[i]));
+        }
+
+        point<double> moved = compute([](auto tr) { return n_o<double> % tr; }, tr);
+        CHECK_EQ(moved.x, doctest::Approx(t.x));
+        CHECK_EQ(moved.y, doctest::Approx(t.y));
+        CHECK_EQ(moved.z, doctest::Approx(t.z));
+
+        auto const log_tr = compute([](auto tr) { return versor_log(tr); }, tr);
+        for (size_t i = 0; i != b.size(); ++i)
+        {
+            CHECK_EQ(log_tr.select(b.elements[i]), doctest::Approx(b[i]));
+        }
+    }
+
+    SUBCASE("screw")
+    {
+        // A rotation about the z axis combined with a translation along it produces a grade 4 component
+        auto b = compute(
+            [](auto axis) {
+                auto line = (n_o<double> ^ axis ^ n_i<double>) >> ips<double>;
+                return frac<3, 4> * line + frac<-1, 2> * (extract<0b100>{}(axis) ^ n_i<double>);
+            },
+            axis);
+        auto m = compute([](auto b) { return versor_exp(b); }, b);
+        CHECK_EQ(m[0], doctest::Approx(std::cos(0.75)));
+
+        auto const log_m = compute([](auto m) { return versor_log(m); }, m);
+        for (size_t i = 0; i != b.size(); ++i)
+        {
+            CHECK_EQ(log_m.select(b.elements[i]), doctest::Approx(b[i]));
+        }
+    }
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/diff.hpp>
+#include <gal/pga.hpp>
+
+#include <cmath>
+
+using namespace gal;
+using namespace gal::pga;
+
+TEST_SUITE_BEGIN("diff");
+
+// Central difference of the lambda with respect to component C of its I-th input
+template <size_t I, size_t C, typename L, typename... Data>
+auto central_difference(L lambda, Data... input)
+{
+    constexpr double h = 1e-5;
+    auto lo            = std::make_tuple(input...);
+    auto hi            = std::make_tuple(input...);
+    std::get<I>(lo)[C] -= h;
+    std::get<I>(hi)[C] += h;
+    auto f_lo = std::apply([&](auto... in) { return compute(lambda, in...); }, lo);
+    auto f_hi = std::apply([&](auto... in) { return compute(lambda, in...); }, hi);
+
+    auto out = f_lo;
+    for (size_t k = 0; k != out.size(); ++k)
+    {
+        out[k] = (f_hi[k] - f_lo[k]) / (2 * h);
+    }
+    return out;
+}
+
+// Compare derivatives element by element as components which vanish identically are absent from the exact derivative
+template <typename T1, typename T2>
+void check_derivative(T1 const& actual, T2 const& expected)
+{
+    for (size_t k = 0; k != expected.size(); ++k)
+    {
+        CHECK_EQ(actual.select(T2::elements[k]), doctest::Approx(expected[k]));
+    }
+}
+
+TEST_CASE("polynomial-derivative")
+{
+    using scalar_t = scalar<pga_algebra, double>;
+    scalar_t x{1.5};
+    scalar_t y{-0.25};
+
+    // d/dx (x^3 y + 3x^2 + y^2) = 3x^2 y + 6x
+    auto polynomial = [](auto x, auto y) { return x * x * x * y + frac<3> * x * x + y * y; };
+    auto dx         = compute(diff<0>(polynomial), x, y);
+    CHECK_EQ(dx[0], doctest::Approx(3 * 1.5 * 1.5 * -0.25 + 6 * 1.5));
+
+    // The derivative is a polynomial of lower degree evaluated like any other
+    constexpr auto ops = evaluate<scalar_t, scalar_t>{}.ops(diff<0>(polynomial));
+    static_assert(ops.multiplies == 4);
+
+    // Derivatives of derivatives
+    auto dxy = compute(diff<1>(diff<0>(polynomial)), x, y);
+    CHECK_EQ(dxy[0], doctest::Approx(3 * 1.5 * 1.5));
+
+    // Derivatives with respect to inputs which do not appear vanish in every component
+    auto none = compute(diff<1>([](auto x, auto) { return x * x; }), x, y);
+    static_assert(decltype(none)::size() == 0);
+}
+
+TEST_CASE("sandwich-derivative")
+{
+    point<double> p{1.0, -2.0, 3.0};
+    motor<double> m{0.92388, 0.5, -0.25, 0.0, 0.125, 0.38268, 0.0, 0.0625};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    auto check = [&](auto index) {
+        constexpr size_t c = decltype(index)::value;
+        check_derivative(compute(diff<1, c>(sandwich), p, m), central_difference<1, c>(sandwich, p, m));
+    };
+    check(std::integral_constant<size_t, 0>{});
+    check(std::integral_constant<size_t, 3>{});
+    check(std::integral_constant<size_t, 7>{});
+
+    // Only the terms involving the differentiated component of the motor are retained
+    constexpr auto full       = evaluate<point<double>, motor<double>>{}.ops(sandwich);
+    constexpr auto derivative = evaluate<point<double>, motor<double>>{}.ops(diff<1, 3>(sandwich));
+    static_assert(derivative.multiplies < full.multiplies);
+}
+
+TEST_CASE("chain-rule")
+{
+    using scalar_t = scalar<pga_algebra, double>;
+    scalar_t a{0.3};
+    scalar_t b{0.7};
+
+    auto f = [](auto a, auto b) {
+        return sin(a * b) * sqrt(frac<2> + a * a) + cos(b) * exp(a) + atan2(a, b) * inv(frac<1> + b * b);
+    };
+    auto [da, db] = compute<opt::cse>(jacobian<0, 1>(f), a, b);
+    CHECK_EQ(da[0], doctest::Approx(central_difference<0, 0>(f, a, b)[0]));
+    CHECK_EQ(db[0], doctest::Approx(central_difference<1, 0>(f, a, b)[0]));
+}
+
+TEST_CASE("joint-jacobian")
+{
+    // The tip of an arm with revolute joints about the z axis and a parallel line, the second carried by the first
+    using scalar_t = scalar<pga_algebra, double>;
+    auto tip       = [](auto a1, auto a2, auto l1, auto l2, auto p) {
+        return p % (versor_exp(frac<1, 2> * a1 * l1) * versor_exp(frac<1, 2> * a2 * l2));
+    };
+    scalar_t a1{0.4};
+    scalar_t a2{-1.1};
+    constant<line<double>, 0, 0, 1, 0, 0, 0> l1;
+    constant<line<double>, 0, 0, 1, 1, 0, 0> l2;
+    constant<point<double>, 1, 2, 0> p;
+
+    // Both columns of the Jacobian come out of a single kernel
+    auto [j1, j2] = compute<opt::cse>(jacobian<0, 1>(tip), a1, a2, l1, l2, p);
+    check_derivative(j1, central_difference<0, 0>(tip, a1, a2, l1, l2, p));
+    check_derivative(j2, central_difference<1, 0>(tip, a1, a2, l1, l2, p));
+}
+
+TEST_SUITE_END();
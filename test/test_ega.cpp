@@ -5,6 +5,7 @@
 #include <gal/expression_debug.hpp>
 #include <gal/format.hpp>
 
+#include <cmath>
 #include <cstdio>
 
 using namespace gal::ega;
@@ -130,4 +131,35 @@ TEST_CASE("rotors")
     }
 }
 
+TEST_CASE("versor-exp-log")
+{
+    vector<double> axis{0.3, -1.2, 0.5};
+    vector<double> v{1, 2, 3};
+
+    // The bivector dual to the axis scaled by half the angle generates the rotation by |axis| about the axis
+    auto r = compute([](auto axis) { return gal::versor_exp(gal::frac<-1, 2> * !axis); }, axis);
+    double angle = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    CHECK_EQ(r[0], doctest::Approx(std::cos(angle / 2)));
+
+    rotor<double> expected{angle, axis.x / angle, axis.y / angle, axis.z / angle};
+    vector<double> rotated   = compute([](auto r, auto v) { return v % r; }, r, v);
+    vector<double> reference = compute([](auto r, auto v) { return v % r; }, expected, v);
+    CHECK_EQ(rotated.x, doctest::Approx(reference.x));
+    CHECK_EQ(rotated.y, doctest::Approx(reference.y));
+    CHECK_EQ(rotated.z, doctest::Approx(reference.z));
+
+    auto log_r = compute([](auto r) { return gal::versor_log(r); }, r);
+    auto half  = compute([](auto axis) { return gal::frac<-1, 2> * !axis; }, axis);
+    static_assert(log_r.size() == half.size());
+    for (size_t i = 0; i != half.size(); ++i)
+    {
+        CHECK_EQ(log_r[i], doctest::Approx(half[i]));
+    }
+
+    // The exponential of a vanishing bivector is the identity rather than NaN
+    vector<double> zero{0, 0, 0};
+    auto identity = compute([](auto axis) { return gal::versor_exp(!axis); }, zero);
+    CHECK_EQ(identity[0], doctest::Approx(1));
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,539 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/pga.hpp>
+
+#include <vector>
+
+using namespace gal;
+using namespace gal::pga;
+
+TEST_SUITE_BEGIN("engine");
+
+TEST_CASE("batch-evaluation")
+{
+    auto sandwich = [](auto p, auto m) { return p % m; };
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+
+    // 37 is deliberately not a multiple of the batch width so the tail block is exercised
+    std::vector<point<float>> points;
+    for (size_t i = 0; i != 37; ++i)
+    {
+        points.emplace_back(static_cast<float>(i), 1.f - static_cast<float>(i), 0.5f * static_cast<float>(i));
+    }
+
+    SUBCASE("broadcast-motor")
+    {
+        auto out = points;
+        compute_batch(sandwich, points.size(), out.data(), points.data(), m);
+
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            point<float> expected = compute(sandwich, points[i], m);
+            CHECK_EQ(out[i].x, doctest::Approx(expected.x));
+            CHECK_EQ(out[i].y, doctest::Approx(expected.y));
+            CHECK_EQ(out[i].z, doctest::Approx(expected.z));
+        }
+    }
+
+    SUBCASE("entity-output")
+    {
+        using result_t = decltype(compute(sandwich, points[0], m));
+        std::vector<result_t> out(points.size());
+        std::vector<motor<float>> motors(points.size(), m);
+        compute_batch(sandwich, points.size(), out.data(), points.data(), motors.data());
+
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            auto expected = compute(sandwich, points[i], m);
+            for (size_t j = 0; j != result_t::size(); ++j)
+            {
+                CHECK_EQ(out[i][j], doctest::Approx(expected[j]));
+            }
+        }
+    }
+
+    SUBCASE("structure-of-arrays")
+    {
+        std::vector<float> coordinates[3];
+        for (auto const& p : points)
+        {
+            coordinates[0].push_back(p.x);
+            coordinates[1].push_back(p.y);
+            coordinates[2].push_back(p.z);
+        }
+
+        // Transform the points in place
+        soa<point<float>> view{{coordinates[0].data(), coordinates[1].data(), coordinates[2].data()}};
+        compile<point<float>, motor<float>>(sandwich)(points.size(), view, view, m);
+
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            point<float> expected = compute(sandwich, points[i], m);
+            CHECK_EQ(coordinates[0][i], doctest::Approx(expected.x));
+            CHECK_EQ(coordinates[1][i], doctest::Approx(expected.y));
+            CHECK_EQ(coordinates[2][i], doctest::Approx(expected.z));
+        }
+    }
+}
+
+TEST_CASE("common-subexpression-elimination")
+{
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+
+    SUBCASE("sandwich")
+    {
+        auto sandwich = [](auto p, auto m) { return p % m; };
+        point<float> p{1.f, -2.f, 3.f};
+
+        point<float> expected = compute(sandwich, p, m);
+        point<float> actual   = compute<opt::cse>(sandwich, p, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+
+        constexpr auto stats = evaluate<point<float>, motor<float>>{}.cse(sandwich);
+        static_assert(stats.after.multiplies < stats.before.multiplies);
+        CHECK_LE(stats.after.additions, stats.before.additions);
+    }
+
+    SUBCASE("motor-composition")
+    {
+        auto conjugate = [](auto m1, auto m2) { return m1 * m2 * ~m1; };
+        motor<float> m2{0.5f, 0.5f, 0.5f, 0.f, 0.5f, 0.25f, -0.5f, 0.f};
+
+        auto expected = compute(conjugate, m, m2);
+        auto actual   = compute<opt::cse>(conjugate, m, m2);
+        for (size_t i = 0; i != expected.size(); ++i)
+        {
+            CHECK_EQ(actual[i], doctest::Approx(expected[i]));
+        }
+
+        constexpr auto stats = evaluate<motor<float>, motor<float>>{}.cse(conjugate);
+        static_assert(stats.after.multiplies < stats.before.multiplies);
+    }
+}
+
+TEST_CASE("multiple-outputs")
+{
+    // The results share the monomials of p1 & p2
+    auto lines = [](auto p1, auto p2, auto p3) {
+        auto l = p1 & p2;
+        return std::make_tuple(l, l & p3, l * l);
+    };
+    point<float> p1{1.f, 0.f, 2.f};
+    point<float> p2{0.f, 1.f, -1.f};
+    point<float> p3{3.f, 1.f, 0.5f};
+
+    auto&& [l, pl, l2] = compute(lines, p1, p2, p3);
+    auto l_expected    = compute([](auto p1, auto p2) { return p1 & p2; }, p1, p2);
+    auto pl_expected   = compute([](auto p1, auto p2, auto p3) { return p1 & p2 & p3; }, p1, p2, p3);
+    auto l2_expected   = compute([](auto p1, auto p2) { return (p1 & p2) * (p1 & p2); }, p1, p2);
+
+    auto check = [](auto const& actual, auto const& expected) {
+        REQUIRE_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i != expected.size(); ++i)
+        {
+            CHECK_EQ(actual[i], doctest::Approx(expected[i]));
+        }
+    };
+    check(l, l_expected);
+    check(pl, pl_expected);
+    check(l2, l2_expected);
+
+    auto&& [l_cse, pl_cse, l2_cse] = compute<opt::cse>(lines, p1, p2, p3);
+    check(l_cse, l_expected);
+    check(pl_cse, pl_expected);
+    check(l2_cse, l2_expected);
+
+    // The fused kernel costs less than evaluating each result independently
+    using evaluate_t = evaluate<point<float>, point<float>, point<float>>;
+    constexpr auto l_ops  = detail::table_ops(evaluate_t{}([](auto p1, auto p2, auto) { return p1 & p2; }));
+    constexpr auto pl_ops = detail::table_ops(evaluate_t{}([](auto p1, auto p2, auto p3) { return p1 & p2 & p3; }));
+    constexpr auto l2_ops = detail::table_ops(evaluate_t{}([](auto p1, auto p2, auto) { return (p1 & p2) * (p1 & p2); }));
+    constexpr auto separate = l_ops.multiplies + pl_ops.multiplies + l2_ops.multiplies;
+    constexpr auto stats = evaluate_t{}.cse(lines);
+    static_assert(stats.before.multiplies < separate);
+    static_assert(stats.after.multiplies <= stats.before.multiplies);
+}
+
+TEST_CASE("horner-factorization")
+{
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    point<float> p{1.f, -2.f, 3.f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    point<float> expected = compute(sandwich, p, m);
+    point<float> actual   = compute<opt::factor>(sandwich, p, m);
+    CHECK_EQ(actual.x, doctest::Approx(expected.x));
+    CHECK_EQ(actual.y, doctest::Approx(expected.y));
+    CHECK_EQ(actual.z, doctest::Approx(expected.z));
+
+    constexpr auto flat     = evaluate<point<float>, motor<float>>{}.ops(sandwich);
+    constexpr auto factored = evaluate<point<float>, motor<float>>{}.ops<opt::factor>(sandwich);
+    static_assert(factored.multiplies < flat.multiplies);
+    static_assert(factored.additions == flat.additions);
+
+    SUBCASE("powers")
+    {
+        // x^3 + x^2*y + x -> x*(x*(x + y) + 1)
+        auto polynomial = [](auto s1, auto s2) { return s1 * s1 * s1 + s1 * s1 * s2 + s1; };
+        scalar<pga_algebra, float> x{1.5f};
+        scalar<pga_algebra, float> y{-0.25f};
+
+        auto result = compute<opt::factor>(polynomial, x, y);
+        CHECK_EQ(result[0], doctest::Approx(1.5f * 1.5f * 1.5f - 1.5f * 1.5f * 0.25f + 1.5f));
+
+        constexpr auto ops = evaluate<scalar<pga_algebra, float>, scalar<pga_algebra, float>>{}.ops<opt::factor>(polynomial);
+        static_assert(ops.multiplies == 2);
+        static_assert(ops.additions == 2);
+    }
+}
+
+TEST_CASE("power-table")
+{
+    // x^2 is shared by two monomials and evaluated once
+    auto polynomial = [](auto x, auto y) { return x * x * y + x * x + y * y * x; };
+    scalar<pga_algebra, float> x{1.5f};
+    scalar<pga_algebra, float> y{-0.25f};
+
+    auto result = compute(polynomial, x, y);
+    CHECK_EQ(result[0], doctest::Approx(1.5f * 1.5f * -0.25f + 1.5f * 1.5f + 0.25f * 0.25f * 1.5f));
+
+    constexpr auto ops = evaluate<scalar<pga_algebra, float>, scalar<pga_algebra, float>>{}.ops(polynomial);
+    static_assert(ops.multiplies == 4);
+    static_assert(ops.additions == 2);
+}
+
+TEST_CASE("fused-multiply-add")
+{
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    point<float> p{1.f, -2.f, 3.f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    point<float> expected = compute(sandwich, p, m);
+
+    SUBCASE("default")
+    {
+        point<float> actual = compute<fp::fma>(sandwich, p, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("cse")
+    {
+        point<float> actual = compute<opt::cse, fp::fma>(sandwich, p, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    constexpr auto plain = evaluate<point<float>, motor<float>>{}.ops(sandwich);
+    constexpr auto fused = evaluate<point<float>, motor<float>>{}.ops<fp::fma>(sandwich);
+    static_assert(fused.multiplies == plain.multiplies);
+    static_assert(fused.additions == plain.additions);
+    static_assert(fused.depth < plain.depth);
+
+    constexpr auto cse       = evaluate<point<float>, motor<float>>{}.ops<opt::cse>(sandwich);
+    constexpr auto cse_fused = evaluate<point<float>, motor<float>>{}.ops<opt::cse, fp::fma>(sandwich);
+    static_assert(cse_fused.depth <= cse.depth);
+}
+
+TEST_CASE("constant-inputs")
+{
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    SUBCASE("integral")
+    {
+        point<float> expected = compute(sandwich, point<float>{0.f, 0.f, 1.f}, m);
+        point<float> actual   = compute(sandwich, constant<point<float>, 0, 0, 1>{}, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("rational")
+    {
+        point<float> expected = compute(sandwich, point<float>{0.5f, -1.25f, 3.f}, m);
+        point<float> actual   = compute(sandwich, rational_constant<point<float>, 4, 2, -5, 12>{}, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("batch")
+    {
+        std::array<motor<float>, 3> motors = {m, m, m};
+        std::array<point<float>, 3> out    = {point<float>{0, 0, 0}, point<float>{0, 0, 0}, point<float>{0, 0, 0}};
+        compute_batch(sandwich, motors.size(), out.data(), constant<point<float>, 0, 0, 1>{}, motors.data());
+
+        point<float> expected = compute(sandwich, point<float>{0.f, 0.f, 1.f}, m);
+        CHECK_EQ(out[2].x, doctest::Approx(expected.x));
+        CHECK_EQ(out[2].z, doctest::Approx(expected.z));
+    }
+
+    // Zero coordinates prune their monomials and no indeterminates are read for the constant
+    constexpr auto runtime = evaluate<point<float>, motor<float>>{}.ops(sandwich);
+    constexpr auto folded  = evaluate<constant<point<float>, 0, 0, 1>, motor<float>>{}.ops(sandwich);
+    static_assert(folded.multiplies < runtime.multiplies);
+    static_assert(folded.additions < runtime.additions);
+}
+
+TEST_CASE("compiled-kernel")
+{
+    auto sandwich = compile<point<float>, motor<float>>([](auto p, auto m) { return p % m; });
+    auto sandwich_cse = compile<point<float>, motor<float>>([](auto p, auto m) { return p % m; }, opt::cse{});
+    using kernel_t    = decltype(sandwich);
+
+    static_assert(kernel_t::input_count == 2);
+    static_assert(kernel_t::input_size == 11);
+    static_assert(kernel_t::output_size == kernel_t::result_t::size());
+    static_assert(decltype(sandwich_cse)::flops < kernel_t::flops);
+
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+
+    struct body
+    {
+        float mass;
+        point<float> position;
+    };
+    std::vector<body> bodies;
+    for (size_t i = 0; i != 21; ++i)
+    {
+        bodies.push_back({1.f, {static_cast<float>(i), 2.f, -0.5f * static_cast<float>(i)}});
+    }
+
+    SUBCASE("single")
+    {
+        point<float> expected = compute([](auto p, auto m) { return p % m; }, bodies[3].position, m);
+        point<float> actual   = sandwich(bodies[3].position, m);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("strided")
+    {
+        std::vector<point<float>> out(bodies.size(), bodies[0].position);
+        strided<point<float> const> positions{&bodies[0].position, sizeof(body)};
+        sandwich_cse(bodies.size(), out.data(), positions, m);
+
+        // Transform the positions in place
+        sandwich(bodies.size(), strided<point<float>>{&bodies[0].position, sizeof(body)}, positions, m);
+
+        for (size_t i = 0; i != bodies.size(); ++i)
+        {
+            CHECK_EQ(bodies[i].position.x, doctest::Approx(out[i].x));
+            CHECK_EQ(bodies[i].position.y, doctest::Approx(out[i].y));
+            CHECK_EQ(bodies[i].position.z, doctest::Approx(out[i].z));
+            CHECK_EQ(bodies[i].mass, 1.f);
+        }
+    }
+}
+
+TEST_CASE("bound-kernel")
+{
+    auto sandwich = compile<point<float>, motor<float>>([](auto p, auto m) { return p % m; });
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    auto transform = sandwich.bind<1>(m);
+    using bound_t  = decltype(transform);
+
+    // The matrix of the motion and its weight
+    static_assert(bound_t::coefficient_count == 13);
+    static_assert(bound_t::ops.multiplies == 9);
+
+    std::vector<point<float>> points;
+    for (size_t i = 0; i != 37; ++i)
+    {
+        points.push_back({static_cast<float>(i), 1.f - static_cast<float>(i), 0.25f * static_cast<float>(i)});
+    }
+
+    SUBCASE("single")
+    {
+        for (auto const& p : points)
+        {
+            point<float> expected = sandwich(p, m);
+            point<float> actual   = transform(p);
+            CHECK_EQ(actual.x, doctest::Approx(expected.x));
+            CHECK_EQ(actual.y, doctest::Approx(expected.y));
+            CHECK_EQ(actual.z, doctest::Approx(expected.z));
+        }
+    }
+
+    SUBCASE("batch")
+    {
+        std::vector<point<float>> out(points.size(), points[0]);
+        transform(points.size(), out.data(), points.data());
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            point<float> expected = sandwich(points[i], m);
+            CHECK_EQ(out[i].x, doctest::Approx(expected.x));
+            CHECK_EQ(out[i].y, doctest::Approx(expected.y));
+            CHECK_EQ(out[i].z, doctest::Approx(expected.z));
+        }
+    }
+
+    SUBCASE("staged")
+    {
+        // The normalization of the plane is computed once when binding it while the sine stays per invocation
+        using scalar_t = scalar<pga_algebra, float>;
+        auto distance  = compile<plane<float>, point<float>, scalar_t>(
+            [](auto pl, auto p, auto s) { return (pl ^ p) * inv(sqrt(pl | pl)) * sin(s); }, opt::cse{});
+        plane<float> pl{1.f, 2.f, 3.f, 4.f};
+        auto to_plane = distance.bind<0>(pl);
+        static_assert(decltype(to_plane)::ops.multiplies < decltype(distance)::ops.multiplies);
+
+        std::vector<scalar_t> angles;
+        for (size_t i = 0; i != 19; ++i)
+        {
+            angles.push_back({0.1f * static_cast<float>(i)});
+        }
+        std::vector<entity<pga_algebra, float, 0b1111>> out(angles.size());
+        to_plane(angles.size(), out.data(), points[3], angles.data());
+        for (size_t i = 0; i != angles.size(); ++i)
+        {
+            auto expected = distance(pl, points[3], angles[i]);
+            CHECK_EQ(to_plane(points[3], angles[i])[0], doctest::Approx(expected[0]));
+            CHECK_EQ(out[i][0], doctest::Approx(expected[0]));
+        }
+
+        // Binding an input other than the first
+        auto at_point = distance.bind<1>(points[3]);
+        CHECK_EQ(at_point(pl, angles[5])[0], doctest::Approx(distance(pl, points[3], angles[5])[0]));
+    }
+}
+
+TEST_CASE("kernel-stats")
+{
+    constexpr auto stats = kernel_stats<point<float>, motor<float>>([](auto p, auto m) { return p % m; });
+    static_assert(stats.terms == 4);
+    static_assert(stats.max_degree == 3);
+    static_assert(stats.multiplies == evaluate<point<float>, motor<float>>{}.ops([](auto p, auto m) { return p % m; }).multiplies);
+    CHECK_GT(stats.monomials, stats.terms);
+
+    constexpr auto cse_stats = kernel_stats<point<float>, motor<float>>([](auto p, auto m) { return p % m; }, opt::cse{});
+    static_assert(cse_stats.monomials == stats.monomials);
+    static_assert(cse_stats.multiplies < stats.multiplies);
+
+    GAL_KERNEL_BUDGET(stats, 100);
+    GAL_KERNEL_BUDGET((kernel_stats<point<float>, motor<float>>([](auto p, auto m) { return p % m; }, opt::factor{})), 50);
+
+    auto kernel = compile<point<float>, motor<float>>([](auto p, auto m) { return p % m; });
+    GAL_KERNEL_BUDGET(decltype(kernel)::ops, 100);
+}
+
+TEST_CASE("deferred-computation")
+{
+    motor<float> m1{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    motor<float> m2{0.5f, 0.5f, 0.5f, 0.f, 0.5f, 0.25f, -0.5f, 0.f};
+    point<float> p{1.f, 2.f, 3.f};
+
+    auto compose  = [](auto m1, auto m2) { return m2 * m1; };
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    auto m21              = compute(compose, m1, m2);
+    point<float> expected = compute(sandwich, p, m21);
+
+    auto m21_deferred = defer(compose, m1, m2);
+    static_assert(decltype(m21_deferred)::ind_count() == motor<float>::ind_count() * 2);
+
+    SUBCASE("value")
+    {
+        auto actual = m21_deferred.value();
+        for (size_t i = 0; i != actual.size(); ++i)
+        {
+            CHECK_EQ(actual[i], doctest::Approx(m21[i]));
+        }
+    }
+
+    SUBCASE("fused")
+    {
+        point<float> actual = compute(sandwich, p, m21_deferred);
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("nested")
+    {
+        point<float> actual = defer(sandwich, p, m21_deferred).value();
+        CHECK_EQ(actual.x, doctest::Approx(expected.x));
+        CHECK_EQ(actual.y, doctest::Approx(expected.y));
+        CHECK_EQ(actual.z, doctest::Approx(expected.z));
+    }
+
+    SUBCASE("batch")
+    {
+        std::vector<point<float>> points(5, p);
+        std::vector<point<float>> out(5, p);
+        compute_batch(sandwich, points.size(), out.data(), points.data(), m21_deferred);
+        for (auto const& actual : out)
+        {
+            CHECK_EQ(actual.x, doctest::Approx(expected.x));
+            CHECK_EQ(actual.y, doctest::Approx(expected.y));
+            CHECK_EQ(actual.z, doctest::Approx(expected.z));
+        }
+    }
+}
+
+TEST_CASE("staged-scalar-functions")
+{
+    using scalar_t = scalar<pga_algebra, float>;
+    scalar_t a{0.3f};
+    scalar_t b{0.7f};
+
+    SUBCASE("normalize")
+    {
+        plane<float> p{2.f, 3.f, 4.f, 12.f};
+        plane<float> actual = compute([](auto p) { return p * inv(sqrt(p | p)); }, p);
+        CHECK_EQ(actual.d, doctest::Approx(2.f / 13.f));
+        CHECK_EQ(actual.x, doctest::Approx(3.f / 13.f));
+        CHECK_EQ(actual.y, doctest::Approx(4.f / 13.f));
+        CHECK_EQ(actual.z, doctest::Approx(12.f / 13.f));
+    }
+
+    SUBCASE("nested")
+    {
+        // The argument of atan2 depends on earlier stages, and the repeated sin(a) is staged once
+        auto angle  = [](auto a, auto b) { return atan2(sin(a), cos(a)) * exp(b) + sin(a) * sin(a); };
+        auto result = compute(angle, a, b);
+        CHECK_EQ(result[0], doctest::Approx(0.3f * std::exp(0.7f) + std::sin(0.3f) * std::sin(0.3f)));
+
+        constexpr auto ops = evaluate<scalar_t, scalar_t>{}.ops(angle);
+        static_assert(ops.multiplies == 6);
+    }
+
+    SUBCASE("multiple-outputs")
+    {
+        auto [one, reciprocal] = compute<opt::cse>(
+            [](auto a, auto b) { return std::make_tuple(sin(a) * sin(a) + cos(a) * cos(a), inv(b)); }, a, b);
+        CHECK_EQ(one[0], doctest::Approx(1.f));
+        CHECK_EQ(reciprocal[0], doctest::Approx(1.f / 0.7f));
+    }
+
+    SUBCASE("batch")
+    {
+        std::vector<scalar_t> in;
+        for (size_t i = 0; i != 19; ++i)
+        {
+            in.push_back({0.1f * static_cast<float>(i)});
+        }
+        std::vector<entity<pga_algebra, float, 0>> out(in.size());
+        compute_batch([](auto a, auto b) { return sin(a) * b; }, in.size(), out.data(), in.data(), b);
+        for (size_t i = 0; i != in.size(); ++i)
+        {
+            CHECK_EQ(out[i][0], doctest::Approx(std::sin(in[i].value) * 0.7f));
+        }
+    }
+
+    SUBCASE("deferred")
+    {
+        auto root   = defer([](auto a) { return sqrt(a); }, a);
+        auto result = compute([](auto root, auto b) { return root * b; }, root, b);
+        CHECK_EQ(result[0], doctest::Approx(std::sqrt(0.3f) * 0.7f));
+    }
+}
+
+TEST_SUITE_END();
@@ -47,6 +47,11 @@ TEST_CASE("cga-ik")
     auto&& [R1, R2, R3, T2, R4, Rg, Jg_f] = gabenchmark::InverseKinematics(ang1, ang2, ang3, ang4, ang5);
 
     CHECK_EQ(R1[0], doctest::Approx(0.992546).epsilon(0.01));
+
+    // Rotors are exact exponentials, so the gripper remains a normalized point
+    CHECK_EQ(R1[0], doctest::Approx(std::cos(ang1 / 2)));
+    CHECK_EQ(R1[1], doctest::Approx(std::sin(ang1 / 2)));
+    CHECK_EQ(Jg_f[3], doctest::Approx(1)); // n_o coefficient of the normalized gripper point
 }
 
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/parallel.hpp>
+#include <gal/pga.hpp>
+
+#include <vector>
+
+using namespace gal;
+using namespace gal::pga;
+
+TEST_SUITE_BEGIN("parallel");
+
+TEST_CASE("chunk-queue")
+{
+    detail::chunk_queue queue;
+    queue.reset(2, 5);
+
+    CHECK_EQ(queue.pop(), 2);
+    CHECK_EQ(queue.steal(), 4);
+    CHECK_EQ(queue.pop(), 3);
+    CHECK_EQ(queue.steal(), detail::chunk_queue::empty);
+    CHECK_EQ(queue.pop(), detail::chunk_queue::empty);
+}
+
+TEST_CASE("parallel-compute")
+{
+    motor<float> m{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.0625f};
+    auto sandwich = [](auto p, auto m) { return p % m; };
+
+    // An odd count leaves a partial block in the final chunk
+    constexpr size_t count = 10007;
+    std::vector<point<float>> points;
+    points.reserve(count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        points.emplace_back(0.5f * static_cast<float>(i), -1.f, 0.25f);
+    }
+    std::vector<point<float>> expected(count, point<float>{0, 0, 0});
+    compute_batch(sandwich, count, expected.data(), points.data(), m);
+
+    auto mismatches = [&](std::vector<point<float>> const& out) {
+        size_t wrong = 0;
+        for (size_t i = 0; i != out.size(); ++i)
+        {
+            wrong += out[i].x != expected[i].x || out[i].y != expected[i].y || out[i].z != expected[i].z;
+        }
+        return wrong;
+    };
+
+    // Small chunks so that every thread has several to work through (and steal)
+    for (size_t threads : {1, 2, 3, 8})
+    {
+        executor ex{threads, 1024};
+        CHECK_EQ(ex.thread_count(), threads);
+
+        std::vector<point<float>> out(count, point<float>{0, 0, 0});
+        for (int repetition = 0; repetition != 4; ++repetition)
+        {
+            parallel_compute(ex, sandwich, count, out.data(), points.data(), m);
+            CHECK_EQ(mismatches(out), 0);
+        }
+
+        auto kernel = compile<point<float>, motor<float>>(sandwich);
+        std::vector<point<float>> kernel_out(count, point<float>{0, 0, 0});
+        parallel_compute(ex, kernel, count, kernel_out.data(), points.data(), m);
+        CHECK_EQ(mismatches(kernel_out), 0);
+    }
+}
+
+TEST_SUITE_END();
@@ -2,6 +2,8 @@
 #include <gal/pga.hpp>
 #include <gal/format.hpp>
 
+#include <array>
+#include <cmath>
 #include <iostream>
 
 using namespace gal;
@@ -59,4 +61,127 @@ TEST_CASE("motors")
     }
 }
 
+TEST_CASE("versor-exp-log")
+{
+    // A line through the origin along z generates a rotation about it and an ideal line generates a translation
+    line<double> axis{0, 0, 0.35, 0, 0, 0};
+    motor<double> rotation = exp(axis);
+    CHECK_EQ(rotation[0], doctest::Approx(std::cos(0.35)));
+    CHECK_EQ(rotation[3], doctest::Approx(std::sin(0.35)));
+    CHECK_EQ(rotation[7], doctest::Approx(0));
+
+    line<double> ideal{0, 0, 0, 1.5, 0, 0};
+    motor<double> translation = exp(ideal);
+    CHECK_EQ(translation[0], doctest::Approx(1));
+    CHECK_EQ(translation[1], doctest::Approx(1.5));
+
+    // The kernel forms agree with the exponential and logarithm of pga.hpp and invert each other
+    line<double> l{std::array<double, 6>{0.3, -0.2, 0.1, 0.4, 0.25, -0.6}};
+    motor<double> expected = exp(l);
+    auto m                 = compute([](auto l) { return gal::versor_exp(l); }, l);
+    static_assert(m.size() == 8);
+    for (size_t i = 0; i != m.size(); ++i)
+    {
+        CHECK_EQ(m[i], doctest::Approx(expected[i]));
+    }
+
+    auto const log_m = compute([](auto m) { return gal::versor_log(m); }, m);
+    auto in          = compute([](auto l) { return l; }, l);
+    for (size_t i = 0; i != in.size(); ++i)
+    {
+        CHECK_EQ(log_m.select(in.elements[i]), doctest::Approx(in[i]));
+    }
+
+    line<double> log_expected = log(expected);
+    for (size_t i = 0; i != l.size(); ++i)
+    {
+        CHECK_EQ(log_expected[i], doctest::Approx(l[i]));
+    }
+}
+
+TEST_CASE("batch-exp-log")
+{
+    // 37 lines stored as structure-of-arrays, so the tail block is exercised
+    constexpr size_t count = 37;
+    std::array<std::array<float, count>, 6> lines;
+    std::array<std::array<float, count>, 8> motors;
+    std::array<std::array<float, count>, 6> logs;
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t      = static_cast<float>(i);
+        lines[0][i] = 0.1f * t - 1.f;
+        lines[1][i] = std::sin(t);
+        lines[2][i] = 0.5f;
+        lines[3][i] = std::cos(2.f * t);
+        lines[4][i] = 0.2f;
+        lines[5][i] = -0.03f * t;
+    }
+
+    soa<line<float>> line_view;
+    soa<motor<float>> motor_view;
+    soa<line<float>> log_view;
+    for (size_t k = 0; k != 6; ++k)
+    {
+        line_view.data[k] = lines[k].data();
+        log_view.data[k]  = logs[k].data();
+    }
+    for (size_t k = 0; k != 8; ++k)
+    {
+        motor_view.data[k] = motors[k].data();
+    }
+
+    exp(count, motor_view, line_view);
+    log(count, log_view, motor_view);
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        line<float> l{lines[0][i], lines[1][i], lines[2][i], lines[3][i], lines[4][i], lines[5][i]};
+        motor<float> expected = exp(l);
+        for (size_t k = 0; k != 8; ++k)
+        {
+            CHECK_EQ(motors[k][i], doctest::Approx(expected[k]).epsilon(1e-5));
+        }
+
+        // All rotations are by less than a half turn, so the logarithm recovers the line
+        for (size_t k = 0; k != 6; ++k)
+        {
+            CHECK_EQ(logs[k][i], doctest::Approx(l[k]).epsilon(1e-4));
+        }
+    }
+}
+
+TEST_CASE("motor-matrix")
+{
+    // The second line rotates by more than a half turn about x, so the trace of the rotation is negative
+    for (auto l : {line<double>{0.3, -0.2, 0.1, 0.4, 0.25, -0.6}, line<double>{1.5, 0.2, -0.1, 0.4, 0.25, -0.6}})
+    {
+        motor<double> m = exp(l);
+        auto matrix     = to_matrix(m);
+
+        std::array<point<double>, 3> points{point<double>{1, 2, 3}, point<double>{-4, 0.5, 0}, point<double>{0, 0, 0}};
+        std::array<point<double>, 3> transformed = points;
+        transform(points.size(), transformed.data(), transformed.data(), m);
+        for (size_t i = 0; i != points.size(); ++i)
+        {
+            point<double> expected = compute([](auto p, auto m) { return p % m; }, points[i], m);
+            CHECK_EQ(transformed[i].x, doctest::Approx(expected.x));
+            CHECK_EQ(transformed[i].y, doctest::Approx(expected.y));
+            CHECK_EQ(transformed[i].z, doctest::Approx(expected.z));
+        }
+
+        // The scalar of m is positive, so converting back recovers m itself
+        motor<double> recovered = from_matrix(matrix);
+        for (size_t i = 0; i != m.size(); ++i)
+        {
+            CHECK_EQ(recovered[i], doctest::Approx(m[i]));
+        }
+    }
+
+    // Scaling a motor leaves its matrix unchanged
+    motor<double> m{2, 0, 0, 0, -3, 0, 0, 0};
+    auto matrix = to_matrix(m);
+    CHECK_EQ(matrix[0], doctest::Approx(1));
+    CHECK_EQ(matrix[11], doctest::Approx(3));
+}
+
 TEST_SUITE_END();
\ No newline at end of file
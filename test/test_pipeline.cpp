@@ -0,0 +1,108 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/pga.hpp>
+#include <gal/pipeline.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace gal;
+using namespace gal::pga;
+
+TEST_SUITE_BEGIN("pipeline");
+
+TEST_CASE("pipeline-diamond")
+{
+    constexpr size_t count = 1001;
+    std::vector<point<float>> points;
+    std::vector<motor<float>> motors;
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto t = static_cast<float>(i);
+        points.emplace_back(t, 1.f, -2.f);
+        motors.push_back(motor<float>{0.92388f, 0.5f, -0.25f, 0.f, 0.125f, 0.38268f, 0.f, 0.001f * t});
+    }
+
+    // The moved point feeds both branches and must be evaluated once
+    constant<point<float>, 1, 0, 0> shift;
+    source<0, point<float>> point_source;
+    source<1, motor<float>> motor_source;
+    auto moved   = stage([](auto p, auto m) { return p % m; }).after(point_source, motor_source);
+    auto scaled  = stage([](auto p) { return p * frac<2>; }).after(moved);
+    auto shifted = stage([](auto p, auto t) { return p + t; }).after(moved, shift);
+    auto line    = stage([](auto a, auto b) { return a & b; }).after(scaled, shifted);
+
+    auto p = make_pipeline(line, scaled);
+    static_assert(decltype(p)::stage_count == 4);
+
+    // Small chunks so that the run spans many chunks, including a partial one
+    executor ex{3, 512};
+    auto direct = [](auto p, auto m, auto t) {
+        auto moved = p % m;
+        return (moved * frac<2>) & (moved + t);
+    };
+
+    for (int repetition = 0; repetition != 2; ++repetition)
+    {
+        p.run(ex, count, points.data(), motors.data());
+
+        auto const* lines = p.result<0>();
+        CHECK_EQ(lines, p.result(line));
+        size_t wrong = 0;
+        for (size_t i = 0; i != count; ++i)
+        {
+            auto expected = compute(direct, points[i], motors[i], shift);
+            for (size_t k = 0; k != expected.size(); ++k)
+            {
+                float actual = lines[i].select(decltype(expected)::elements[k]);
+                wrong += std::abs(expected[k] - actual) > 1e-3f * (std::abs(expected[k]) + 1.f);
+            }
+        }
+        CHECK_EQ(wrong, 0);
+    }
+}
+
+TEST_CASE("pipeline-shared-lambda")
+{
+    constexpr size_t count = 300;
+    std::vector<point<float>> points;
+    for (size_t i = 0; i != count; ++i)
+    {
+        points.emplace_back(static_cast<float>(i), -1.f, 3.f);
+    }
+
+    // Both stages have the same type but offset by different runtime points, so they are told apart by their ids
+    auto offset = [](auto p, auto t) { return p + t; };
+    source<0, point<float>> point_source;
+    point<float> ta{-3.f, 2.f, -11.f};
+    point<float> tb{4.f, 22.f, -1.f};
+    auto a = stage<1>(offset).after(point_source, ta);
+    auto b = stage<2>(offset).after(point_source, tb);
+
+    auto p = make_pipeline(a, b);
+    static_assert(decltype(p)::stage_count == 2);
+
+    // Without ids the stages would collapse into one, which the pipeline rejects
+    using ambiguous_t = decltype(stage(offset).after(point_source, ta));
+    static_assert(!detail::unambiguous_order<std::tuple<ambiguous_t>, ambiguous_t, ambiguous_t>::value);
+    static_assert(detail::unambiguous_order<std::tuple<ambiguous_t>, ambiguous_t>::value);
+
+    executor ex{2, 512};
+    p.run(ex, count, points.data());
+
+    size_t wrong = 0;
+    for (size_t i = 0; i != count; ++i)
+    {
+        auto expected_a = compute(offset, points[i], ta);
+        auto expected_b = compute(offset, points[i], tb);
+        for (size_t k = 0; k != 3; ++k)
+        {
+            wrong += p.result<0>()[i][k] != expected_a[k];
+            wrong += p.result<1>()[i][k] != expected_b[k];
+        }
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,86 @@
+#include "test_util.hpp"
+
+#include <doctest/doctest.h>
+#include <gal/pga.hpp>
+#include <gal/simd.hpp>
+
+using namespace gal;
+using namespace gal::pga;
+
+TEST_SUITE_BEGIN("simd");
+
+template <typename S>
+void check_sandwich()
+{
+    using T                = typename S::value_t;
+    constexpr size_t width = S::size();
+
+    // Each lane holds a different point
+    std::array<T, width> x;
+    std::array<T, width> y;
+    std::array<T, width> z;
+    for (size_t i = 0; i != width; ++i)
+    {
+        x[i] = static_cast<T>(i);
+        y[i] = static_cast<T>(1) - static_cast<T>(i);
+        z[i] = static_cast<T>(0.5) * static_cast<T>(i);
+    }
+
+    T mc[8] = {0.92388, 0.5, -0.25, 0, 0.125, 0.38268, 0, 0.0625};
+    motor<S> m{S{mc[0]}, S{mc[1]}, S{mc[2]}, S{mc[3]}, S{mc[4]}, S{mc[5]}, S{mc[6]}, S{mc[7]}};
+    motor<T> ms{mc[0], mc[1], mc[2], mc[3], mc[4], mc[5], mc[6], mc[7]};
+    point<S> p{S::load(x.data()), S::load(y.data()), S::load(z.data())};
+
+    point<S> packed = compute([](auto p, auto m) { return p % m; }, p, m);
+
+    for (size_t i = 0; i != width; ++i)
+    {
+        point<T> expected = compute([](auto p, auto m) { return p % m; }, point<T>{x[i], y[i], z[i]}, ms);
+        CHECK_EQ(packed.x[i], doctest::Approx(expected.x));
+        CHECK_EQ(packed.y[i], doctest::Approx(expected.y));
+        CHECK_EQ(packed.z[i], doctest::Approx(expected.z));
+    }
+}
+
+TEST_CASE("packed-compute")
+{
+    SUBCASE("native-width")
+    {
+        check_sandwich<simd<float, native_width>>();
+    }
+
+    SUBCASE("sse2-width")
+    {
+        check_sandwich<simd<float, 4>>();
+    }
+
+    SUBCASE("generic-width")
+    {
+        check_sandwich<simd<double, 2>>();
+    }
+}
+
+TEST_CASE("packed-arithmetic")
+{
+    using S = simd<float, 8>;
+
+    S a{4.f};
+    CHECK_EQ(sqrt(a)[3], doctest::Approx(2.f));
+    CHECK_EQ(fma(S{2.f}, S{3.f}, S{1.f})[7], doctest::Approx(7.f));
+    CHECK_EQ(gal::pow(a, 3, 1)[0], doctest::Approx(64.f));
+    CHECK_EQ(gal::pow(a, -1, 1)[1], doctest::Approx(0.25f));
+    CHECK_EQ(gal::pow(a, 3, 2)[2], doctest::Approx(8.f));
+    CHECK_EQ((-a)[4], doctest::Approx(-4.f));
+    CHECK_EQ((a / S{8.f} - S{1.f})[5], doctest::Approx(-0.5f));
+}
+
+TEST_CASE("isa-dispatch")
+{
+    using fn_t = int (*)();
+    std::array<fn_t, 4> candidates{[] { return 0; }, [] { return 1; }, nullptr, nullptr};
+    auto selected = dispatch(candidates);
+    REQUIRE(selected != nullptr);
+    CHECK_EQ(selected(), host_isa() == simd_isa::scalar ? 0 : 1);
+}
+
+TEST_SUITE_END();